@@ -0,0 +1,43 @@
+// Measures how long the raster engine takes to compose typical page content.
+// Run it again with QT_NO_CPU_FEATURE=avx2 (or "sse2") to compare the drawhelpers.
+var page = require('webpage').create(),
+    system = require('system'),
+    iterations = system.args.length > 1 ? parseInt(system.args[1], 10) : 20,
+    output = '/dev/null';
+
+var cases = {
+    'translucent layers (SourceOver)':
+        '<style>div{position:absolute;width:1000px;height:700px;background:rgba(40,90,200,0.3)}</style>' +
+        '<div style="left:0;top:0"></div><div style="left:12px;top:9px"></div>' +
+        '<div style="left:24px;top:18px"></div><div style="left:36px;top:27px"></div>',
+    'translucent image (argb32 on argb32)':
+        '<canvas id="c" width="1024" height="768" style="opacity:0.6"></canvas>' +
+        '<script>var c=document.getElementById("c").getContext("2d");' +
+        'for(var i=0;i<64;++i){c.fillStyle="rgba("+(i*4)+",80,"+(255-i*4)+",0.5)";c.fillRect(i*16,0,16,768);}</script>',
+    'smooth upscaled image (bilinear)':
+        '<canvas id="c" width="256" height="192" style="width:1024px;height:768px"></canvas>' +
+        '<script>var c=document.getElementById("c").getContext("2d");' +
+        'for(var i=0;i<16;++i){c.fillStyle="rgb("+(i*16)+",120,"+(255-i*16)+")";c.fillRect(i*16,0,16,192);}</script>'
+};
+
+page.viewportSize = { width: 1024, height: 768 };
+
+function bench(name) {
+    var start, elapsed, i;
+    page.content = '<html><body style="margin:0">' + cases[name] + '</body></html>';
+    page.render(output, { format: 'png', quality: 'fast' });
+    start = Date.now();
+    for (i = 0; i < iterations; ++i) {
+        page.render(output, { format: 'bmp' });
+    }
+    elapsed = Date.now() - start;
+    console.log(name + ': ' + (elapsed / iterations).toFixed(1) + ' ms/render');
+}
+
+for (var name in cases) {
+    if (cases.hasOwnProperty(name)) {
+        bench(name);
+    }
+}
+
+phantom.exit();
@@ -0,0 +1,32 @@
+// Measures how many calls per second go through the Qt/JavaScript bridge.
+var fs = require('fs'),
+    page = require('webpage').create(),
+    system = require('system'),
+    iterations = system.args.length > 1 ? parseInt(system.args[1], 10) : 100000;
+
+function bench(name, fn) {
+    var start = Date.now(), i, elapsed;
+    for (i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    elapsed = Math.max(Date.now() - start, 1);
+    console.log(name + ': ' + Math.round(iterations * 1000 / elapsed) + ' calls/s');
+}
+
+bench('page.childFramesCount()', function () {
+    page.childFramesCount();
+});
+bench('page.switchToFrame(int)', function () {
+    page.switchToFrame(0);
+});
+bench('page.switchToFrame(string)', function () {
+    page.switchToFrame('frame');
+});
+bench('fs.isAbsolute(string)', function () {
+    fs.isAbsolute('/tmp');
+});
+bench('fs.exists(string)', function (i) {
+    fs.exists(i % 2 ? '.' : '..');
+});
+
+phantom.exit();
@@ -12,6 +12,45 @@ if (!Date.prototype.toISOString) {
     }
 }
 
+function duration(start, end)
+{
+    return start >= 0 && end >= start ? end - start : -1;
+}
+
+// HAR requires send, wait and receive, which cannot be -1 like the others
+function phase(start, end)
+{
+    return Math.max(0, duration(start, end));
+}
+
+function harTimings(request, startReply, endReply)
+{
+    var t = endReply.timings;
+
+    if (!t || t.sendStart < 0) {
+        // Not fetched over HTTP, e.g. from the cache
+        return {
+            blocked: 0,
+            dns: -1,
+            connect: -1,
+            send: 0,
+            wait: Math.max(0, startReply.time - request.time),
+            receive: Math.max(0, endReply.time - startReply.time),
+            ssl: -1
+        };
+    }
+    return {
+        blocked: t.dnsStart >= 0 ? t.dnsStart : t.sendStart,
+        dns: duration(t.dnsStart, t.dnsEnd),
+        // HAR counts the TLS handshake in the connect time too
+        connect: duration(t.connectStart, t.sslEnd >= 0 ? t.sslEnd : t.connectEnd),
+        send: phase(t.sendStart, t.sendEnd),
+        wait: phase(t.sendEnd, t.responseStart),
+        receive: phase(t.responseStart, t.responseEnd),
+        ssl: duration(t.sslStart, t.sslEnd)
+    };
+}
+
 function createHAR(address, title, startTime, resources)
 {
     var entries = [];
@@ -59,15 +98,7 @@ function createHAR(address, title, startTime, resources)
                 }
             },
             cache: {},
-            timings: {
-                blocked: 0,
-                dns: -1,
-                connect: -1,
-                send: 0,
-                wait: startReply.time - request.time,
-                receive: endReply.time - startReply.time,
-                ssl: -1
-            },
+            timings: harTimings(request, startReply, endReply),
             pageref: address
         });
     });
@@ -85,6 +116,8 @@ function createHAR(address, title, startTime, resources)
                 id: address,
                 title: title,
                 pageTimings: {
+                    onContentLoad: page.timing.domContentLoadedEventStart ?
+                        page.timing.domContentLoadedEventStart - page.timing.navigationStart : -1,
                     onLoad: page.endTime - page.startTime
                 }
             }],
@@ -132,6 +165,7 @@ if (system.args.length === 1) {
             phantom.exit(1);
         } else {
             page.endTime = new Date();
+            page.timing = page.navigationTiming;
             page.title = page.evaluate(function () {
                 return document.title;
             });
@@ -104,6 +104,57 @@ phantom.callback = function(callback) {
     return ret;
 };
 
+// Turns a call tree returned by stopProfiling() into the ".cpuprofile" format
+// of the Chrome DevTools. The profiler measures every call rather than taking
+// samples, so each node gets one sample lasting its whole self time.
+phantom.toCpuProfile = function(profile) {
+    var nodes = [],
+        samples = [],
+        timeDeltas = [],
+        nextId = 1,
+        time = 0,
+        lastSelfTime = 0;
+
+    function addNode(node) {
+        var id = nextId++,
+            entry = {
+                id: id,
+                callFrame: {
+                    functionName: id === 1 ? "(root)" : node.functionName,
+                    scriptId: "0",
+                    url: node.url,
+                    lineNumber: node.lineNumber - 1,
+                    columnNumber: -1
+                },
+                hitCount: node.selfTime > 0 ? 1 : 0,
+                children: []
+            };
+        nodes.push(entry);
+        if (node.selfTime > 0) {
+            // A sample lasts until the next one is taken
+            samples.push(id);
+            timeDeltas.push(lastSelfTime);
+            time += lastSelfTime;
+            lastSelfTime = Math.round(node.selfTime * 1000);
+        }
+        node.children.forEach(function(child) {
+            entry.children.push(addNode(child));
+        });
+        return id;
+    }
+
+    if (profile && profile.head) {
+        addNode(profile.head);
+    }
+    return {
+        nodes: nodes,
+        startTime: 0,
+        endTime: time + lastSelfTime,
+        samples: samples,
+        timeDeltas: timeDeltas
+    };
+};
+
 (function() {
     // CommonJS module implementation follows
 
@@ -320,9 +371,16 @@ phantom.callback = function(callback) {
         mainFilename = joinPath(cwd, basename(require('system').args[0]) || 'repl');
         mainModule._setFilename(mainFilename);
 
-        // include CoffeeScript which takes care of adding .coffee extension (only if not in Webdriver mode)
+        // compile .coffee modules natively, so that they go through the script cache
+        // and the CoffeeScript compiler is only loaded when needed (only if not in Webdriver mode)
         if (!phantom.webdriverMode) {
-            require('_coffee-script');
+            extensions['.coffee'] = function(module, filename) {
+                var result = phantom._coffee2js(fs.read(filename));
+                if (!result[0]) {
+                    throw new Error(filename + ': ' + result[1]);
+                }
+                module._compile(result[1]);
+            };
         }
     }());
 }());
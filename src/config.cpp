@@ -51,20 +51,44 @@ static const struct QCommandLineConfigEntry flags[] =
     { QCommandLine::Option, '\0', "cookies-file", "Sets the file name to store the persistent cookies", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "config", "Specifies JSON-formatted configuration file", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "debug", "Prints additional warning and debug message: 'true' or 'false' (default)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "device-pixel-ratio", "Sets the ratio of device pixels to CSS pixels used when rendering pages (default is 1 or QT_QPA_HEADLESS_DEVICE_PIXEL_RATIO, use 2 for HiDPI captures)", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "disk-cache", "Enables disk cache: 'true' or 'false' (default)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "dns-cache-file", "Keeps resolved host names in the specified file between runs", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "dns-cache-size", "Sets the number of host names kept in the DNS cache, default is 64", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "dns-cache-ttl", "Sets how long host names are kept in the DNS cache (in seconds), default is 60", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "dns-prefetch", "Resolves host names of links and resources before they are needed: 'true' or 'false' (default)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "dpi", "Sets the logical resolution of the headless screen in dots per inch (default is 72 or QT_QPA_HEADLESS_DPI)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "font-snapshot-file", "Keeps a snapshot of the font database in the specified file to speed up start-up", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "fonts-dir", "Uses only the fonts found in the specified directory", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "glyph-cache-size", "Size of the rendered glyph cache shared by all pages (in KB): '4096' (default), '0' disables it", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "http-pipelining", "Sends several HTTP requests ahead on the same connection: 'true' or 'false' (default)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "http-pipeline-depth", "Number of requests sent ahead on a pipelined connection, default is 3 (NOTE: needs '--http-pipelining')", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "ignore-ssl-errors", "Ignores SSL errors (expired/self-signed certificate errors): 'true' or 'false' (default)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "image-decoding-threads", "Number of threads decoding images in the background, '0' to disable (default is one per CPU core)", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "load-images", "Loads all inlined images: 'true' (default) or 'false'", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "local-storage-path", "Specifies the location for offline local storage", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "local-storage-quota", "Sets the maximum size of the offline local storage (in KB)", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "local-to-remote-url-access", "Allows local content to access remote URL: 'true' or 'false' (default)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "max-connections-per-host", "Limits the number of parallel connections to a single host, default is 6", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "max-disk-cache-size", "Limits the size of the disk cache (in KB)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "memory-cache-max-dead-size", "Limits the size of the resources no page uses in the in-memory cache (in KB), default is the cache size", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "memory-cache-min-dead-size", "Size of the resources no page uses kept in the in-memory cache when it is full (in KB), default is 0", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "memory-cache-prune-decoded-images-first", "Drops decoded images before evicting resources from the in-memory cache: 'true' or 'false' (default)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "memory-cache-size", "Limits the size of the in-memory cache of loaded resources (in KB), default is 8192", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "network-archive", "Records the responses to all network requests in the specified file, or serves them from it (see '--network-archive-mode')", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "network-archive-mode", "Sets how the network archive is used: 'replay' (default) or 'record'", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "output-encoding", "Sets the encoding for the terminal output, default is 'utf8'", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "remote-debugger-port", "Starts the script in a debug harness and listens on the specified port", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "remote-debugger-autorun", "Runs the script in the debugger immediately: 'true' or 'false' (default)", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "proxy", "Sets the proxy server, e.g. '--proxy=http://proxy.company.com:8080'", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "proxy-auth", "Provides authentication information for the proxy, e.g. ''-proxy-auth=username:password'", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "proxy-type", "Specifies the proxy type, 'http' (default), 'none' (disable completely), or 'socks5'", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "script-cache", "Keeps scripts compiled from CoffeeScript on disk between runs: 'true' or 'false' (default)", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "script-cache-path", "Sets the directory of the script cache (default is a 'scripts' directory in the user cache directory)", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "script-encoding", "Sets the encoding used for the starting script, default is 'utf8'", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "script-parse-cache-size", "Limits the parse information shared by the scripts of the same source across pages (in KB), default is 8192", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "shared-connections", "Lets all pages reuse each other's idle connections: 'true' (default) or 'false'", QCommandLine::Optional },
+    { QCommandLine::Option, '\0', "trace", "Records where the time goes (network, parsing, layout, painting, script, GC) into the specified file, in Chrome trace-event format", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "web-security", "Enables web security, 'true' (default) or 'false'", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "ssl-protocol", "Sets the SSL protocol (supported protocols: 'SSLv3' (default), 'SSLv2', 'TLSv1', 'any')", QCommandLine::Optional },
     { QCommandLine::Option, '\0', "ssl-certificates-path", "Sets the location for custom CA certificates (if none set, uses system default)", QCommandLine::Optional },
@@ -257,6 +281,216 @@ void Config::setLocalToRemoteUrlAccessEnabled(const bool value)
     m_localToRemoteUrlAccessEnabled = value;
 }
 
+int Config::imageDecodingThreads() const
+{
+    return m_imageDecodingThreads;
+}
+
+void Config::setImageDecodingThreads(const int value)
+{
+    m_imageDecodingThreads = value;
+}
+
+int Config::dnsCacheSize() const
+{
+    return m_dnsCacheSize;
+}
+
+void Config::setDnsCacheSize(const int value)
+{
+    m_dnsCacheSize = value;
+}
+
+int Config::dnsCacheTtl() const
+{
+    return m_dnsCacheTtl;
+}
+
+void Config::setDnsCacheTtl(const int value)
+{
+    m_dnsCacheTtl = value;
+}
+
+QString Config::dnsCacheFile() const
+{
+    return m_dnsCacheFile;
+}
+
+void Config::setDnsCacheFile(const QString &value)
+{
+    m_dnsCacheFile = value;
+}
+
+QString Config::networkArchive() const
+{
+    return m_networkArchive;
+}
+
+void Config::setNetworkArchive(const QString &value)
+{
+    m_networkArchive = value;
+}
+
+QString Config::networkArchiveMode() const
+{
+    return m_networkArchiveMode;
+}
+
+void Config::setNetworkArchiveMode(const QString &value)
+{
+    m_networkArchiveMode = value;
+}
+
+bool Config::dnsPrefetchEnabled() const
+{
+    return m_dnsPrefetchEnabled;
+}
+
+void Config::setDnsPrefetchEnabled(const bool value)
+{
+    m_dnsPrefetchEnabled = value;
+}
+
+QString Config::fontSnapshotFile() const
+{
+    return m_fontSnapshotFile;
+}
+
+void Config::setFontSnapshotFile(const QString &value)
+{
+    m_fontSnapshotFile = value;
+}
+
+QString Config::fontsDir() const
+{
+    return m_fontsDir;
+}
+
+void Config::setFontsDir(const QString &value)
+{
+    m_fontsDir = value;
+}
+
+int Config::glyphCacheSize() const
+{
+    return m_glyphCacheSize;
+}
+
+void Config::setGlyphCacheSize(const int value)
+{
+    m_glyphCacheSize = value;
+}
+
+qreal Config::devicePixelRatio() const
+{
+    return m_devicePixelRatio;
+}
+
+void Config::setDevicePixelRatio(const qreal value)
+{
+    m_devicePixelRatio = value;
+}
+
+int Config::dpi() const
+{
+    return m_dpi;
+}
+
+void Config::setDpi(const int value)
+{
+    m_dpi = value;
+}
+
+QString Config::traceFile() const
+{
+    return m_traceFile;
+}
+
+void Config::setTraceFile(const QString &value)
+{
+    m_traceFile = value;
+}
+
+int Config::memoryCacheSize() const
+{
+    return m_memoryCacheSize;
+}
+
+void Config::setMemoryCacheSize(const int value)
+{
+    m_memoryCacheSize = value;
+}
+
+int Config::memoryCacheMaxDeadSize() const
+{
+    return m_memoryCacheMaxDeadSize;
+}
+
+void Config::setMemoryCacheMaxDeadSize(const int value)
+{
+    m_memoryCacheMaxDeadSize = value;
+}
+
+int Config::memoryCacheMinDeadSize() const
+{
+    return m_memoryCacheMinDeadSize;
+}
+
+void Config::setMemoryCacheMinDeadSize(const int value)
+{
+    m_memoryCacheMinDeadSize = value;
+}
+
+bool Config::memoryCachePruneDecodedImagesFirst() const
+{
+    return m_memoryCachePruneDecodedImagesFirst;
+}
+
+void Config::setMemoryCachePruneDecodedImagesFirst(const bool value)
+{
+    m_memoryCachePruneDecodedImagesFirst = value;
+}
+
+int Config::maxConnectionsPerHost() const
+{
+    return m_maxConnectionsPerHost;
+}
+
+void Config::setMaxConnectionsPerHost(const int value)
+{
+    m_maxConnectionsPerHost = value;
+}
+
+bool Config::httpPipeliningEnabled() const
+{
+    return m_httpPipeliningEnabled;
+}
+
+void Config::setHttpPipeliningEnabled(const bool value)
+{
+    m_httpPipeliningEnabled = value;
+}
+
+int Config::httpPipelineDepth() const
+{
+    return m_httpPipelineDepth;
+}
+
+void Config::setHttpPipelineDepth(const int value)
+{
+    m_httpPipelineDepth = value;
+}
+
+bool Config::sharedConnectionsEnabled() const
+{
+    return m_sharedConnectionsEnabled;
+}
+
+void Config::setSharedConnectionsEnabled(const bool value)
+{
+    m_sharedConnectionsEnabled = value;
+}
+
 QString Config::outputEncoding() const
 {
     return m_outputEncoding;
@@ -364,6 +598,36 @@ void Config::setScriptEncoding(const QString &value)
     m_scriptEncoding = value;
 }
 
+bool Config::scriptCacheEnabled() const
+{
+    return m_scriptCacheEnabled;
+}
+
+void Config::setScriptCacheEnabled(const bool value)
+{
+    m_scriptCacheEnabled = value;
+}
+
+QString Config::scriptCachePath() const
+{
+    return m_scriptCachePath;
+}
+
+void Config::setScriptCachePath(const QString &value)
+{
+    m_scriptCachePath = value;
+}
+
+int Config::scriptParseCacheSize() const
+{
+    return m_scriptParseCacheSize;
+}
+
+void Config::setScriptParseCacheSize(const int value)
+{
+    m_scriptParseCacheSize = value;
+}
+
 QString Config::scriptFile() const
 {
     return m_scriptFile;
@@ -520,6 +784,27 @@ void Config::resetToDefaults()
     m_maxDiskCacheSize = -1;
     m_ignoreSslErrors = false;
     m_localToRemoteUrlAccessEnabled = false;
+    m_imageDecodingThreads = -1;
+    m_maxConnectionsPerHost = 6;
+    m_httpPipeliningEnabled = false;
+    m_httpPipelineDepth = 3;
+    m_sharedConnectionsEnabled = true;
+    m_dnsCacheSize = 64;
+    m_dnsCacheTtl = 60;
+    m_dnsCacheFile.clear();
+    m_networkArchive.clear();
+    m_networkArchiveMode = "replay";
+    m_dnsPrefetchEnabled = false;
+    m_fontSnapshotFile.clear();
+    m_fontsDir.clear();
+    m_glyphCacheSize = 4096;
+    m_devicePixelRatio = 0;
+    m_dpi = 0;
+    m_traceFile.clear();
+    m_memoryCacheSize = -1;
+    m_memoryCacheMaxDeadSize = -1;
+    m_memoryCacheMinDeadSize = -1;
+    m_memoryCachePruneDecodedImagesFirst = false;
     m_outputEncoding = "UTF-8";
     m_proxyType = "http";
     m_proxyHost.clear();
@@ -528,6 +813,9 @@ void Config::resetToDefaults()
     m_proxyAuthPass.clear();
     m_scriptArgs.clear();
     m_scriptEncoding = "UTF-8";
+    m_scriptCacheEnabled = false;
+    m_scriptCachePath.clear();
+    m_scriptParseCacheSize = -1;
     m_scriptFile.clear();
     m_unknownOption.clear();
     m_versionFlag = false;
@@ -605,10 +893,15 @@ void Config::handleOption(const QString &option, const QVariant &value)
     QStringList booleanFlags;
     booleanFlags << "debug";
     booleanFlags << "disk-cache";
+    booleanFlags << "dns-prefetch";
+    booleanFlags << "http-pipelining";
     booleanFlags << "ignore-ssl-errors";
     booleanFlags << "load-images";
     booleanFlags << "local-to-remote-url-access";
+    booleanFlags << "memory-cache-prune-decoded-images-first";
     booleanFlags << "remote-debugger-autorun";
+    booleanFlags << "script-cache";
+    booleanFlags << "shared-connections";
     booleanFlags << "web-security";
     if (booleanFlags.contains(option)) {
         if ((value != "true") && (value != "yes") && (value != "false") && (value != "no")) {
@@ -630,14 +923,62 @@ void Config::handleOption(const QString &option, const QVariant &value)
         setPrintDebugMessages(boolValue);
     }
 
+    if (option == "device-pixel-ratio") {
+        setDevicePixelRatio(value.toDouble());
+    }
+
     if (option == "disk-cache") {
         setDiskCacheEnabled(boolValue);
     }
 
+    if (option == "dns-cache-file") {
+        setDnsCacheFile(value.toString());
+    }
+
+    if (option == "dns-cache-size") {
+        setDnsCacheSize(value.toInt());
+    }
+
+    if (option == "dns-cache-ttl") {
+        setDnsCacheTtl(value.toInt());
+    }
+
+    if (option == "dns-prefetch") {
+        setDnsPrefetchEnabled(boolValue);
+    }
+
+    if (option == "dpi") {
+        setDpi(value.toInt());
+    }
+
+    if (option == "font-snapshot-file") {
+        setFontSnapshotFile(value.toString());
+    }
+
+    if (option == "fonts-dir") {
+        setFontsDir(value.toString());
+    }
+
+    if (option == "glyph-cache-size") {
+        setGlyphCacheSize(value.toInt());
+    }
+
+    if (option == "http-pipelining") {
+        setHttpPipeliningEnabled(boolValue);
+    }
+
+    if (option == "http-pipeline-depth") {
+        setHttpPipelineDepth(value.toInt());
+    }
+
     if (option == "ignore-ssl-errors") {
         setIgnoreSslErrors(boolValue);
     }
 
+    if (option == "image-decoding-threads") {
+        setImageDecodingThreads(value.toInt());
+    }
+
     if (option == "load-images") {
         setAutoLoadImages(boolValue);
     }
@@ -654,10 +995,38 @@ void Config::handleOption(const QString &option, const QVariant &value)
         setLocalToRemoteUrlAccessEnabled(boolValue);
     }
 
+    if (option == "max-connections-per-host") {
+        setMaxConnectionsPerHost(value.toInt());
+    }
+
     if (option == "max-disk-cache-size") {
         setMaxDiskCacheSize(value.toInt());
     }
 
+    if (option == "memory-cache-max-dead-size") {
+        setMemoryCacheMaxDeadSize(value.toInt());
+    }
+
+    if (option == "memory-cache-min-dead-size") {
+        setMemoryCacheMinDeadSize(value.toInt());
+    }
+
+    if (option == "memory-cache-prune-decoded-images-first") {
+        setMemoryCachePruneDecodedImagesFirst(boolValue);
+    }
+
+    if (option == "memory-cache-size") {
+        setMemoryCacheSize(value.toInt());
+    }
+
+    if (option == "network-archive") {
+        setNetworkArchive(value.toString());
+    }
+
+    if (option == "network-archive-mode") {
+        setNetworkArchiveMode(value.toString());
+    }
+
     if (option == "output-encoding") {
         setOutputEncoding(value.toString());
     }
@@ -683,10 +1052,30 @@ void Config::handleOption(const QString &option, const QVariant &value)
         setProxyAuth(value.toString());
     }
 
+    if (option == "script-cache") {
+        setScriptCacheEnabled(boolValue);
+    }
+
+    if (option == "script-cache-path") {
+        setScriptCachePath(value.toString());
+    }
+
     if (option == "script-encoding") {
         setScriptEncoding(value.toString());
     }
 
+    if (option == "script-parse-cache-size") {
+        setScriptParseCacheSize(value.toInt());
+    }
+
+    if (option == "shared-connections") {
+        setSharedConnectionsEnabled(boolValue);
+    }
+
+    if (option == "trace") {
+        setTraceFile(value.toString());
+    }
+
     if (option == "web-security") {
         setWebSecurityEnabled(boolValue);
     }
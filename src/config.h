@@ -46,11 +46,35 @@ class Config: public QObject
     Q_PROPERTY(int maxDiskCacheSize READ maxDiskCacheSize WRITE setMaxDiskCacheSize)
     Q_PROPERTY(bool ignoreSslErrors READ ignoreSslErrors WRITE setIgnoreSslErrors)
     Q_PROPERTY(bool localToRemoteUrlAccessEnabled READ localToRemoteUrlAccessEnabled WRITE setLocalToRemoteUrlAccessEnabled)
+    Q_PROPERTY(int imageDecodingThreads READ imageDecodingThreads WRITE setImageDecodingThreads)
+    Q_PROPERTY(int maxConnectionsPerHost READ maxConnectionsPerHost WRITE setMaxConnectionsPerHost)
+    Q_PROPERTY(bool httpPipeliningEnabled READ httpPipeliningEnabled WRITE setHttpPipeliningEnabled)
+    Q_PROPERTY(int httpPipelineDepth READ httpPipelineDepth WRITE setHttpPipelineDepth)
+    Q_PROPERTY(bool sharedConnectionsEnabled READ sharedConnectionsEnabled WRITE setSharedConnectionsEnabled)
+    Q_PROPERTY(int dnsCacheSize READ dnsCacheSize WRITE setDnsCacheSize)
+    Q_PROPERTY(int dnsCacheTtl READ dnsCacheTtl WRITE setDnsCacheTtl)
+    Q_PROPERTY(QString dnsCacheFile READ dnsCacheFile WRITE setDnsCacheFile)
+    Q_PROPERTY(QString networkArchive READ networkArchive WRITE setNetworkArchive)
+    Q_PROPERTY(QString networkArchiveMode READ networkArchiveMode WRITE setNetworkArchiveMode)
+    Q_PROPERTY(bool dnsPrefetchEnabled READ dnsPrefetchEnabled WRITE setDnsPrefetchEnabled)
+    Q_PROPERTY(QString fontSnapshotFile READ fontSnapshotFile WRITE setFontSnapshotFile)
+    Q_PROPERTY(QString fontsDir READ fontsDir WRITE setFontsDir)
+    Q_PROPERTY(int glyphCacheSize READ glyphCacheSize WRITE setGlyphCacheSize)
+    Q_PROPERTY(qreal devicePixelRatio READ devicePixelRatio WRITE setDevicePixelRatio)
+    Q_PROPERTY(int dpi READ dpi WRITE setDpi)
+    Q_PROPERTY(QString traceFile READ traceFile WRITE setTraceFile)
+    Q_PROPERTY(int memoryCacheSize READ memoryCacheSize WRITE setMemoryCacheSize)
+    Q_PROPERTY(int memoryCacheMaxDeadSize READ memoryCacheMaxDeadSize WRITE setMemoryCacheMaxDeadSize)
+    Q_PROPERTY(int memoryCacheMinDeadSize READ memoryCacheMinDeadSize WRITE setMemoryCacheMinDeadSize)
+    Q_PROPERTY(bool memoryCachePruneDecodedImagesFirst READ memoryCachePruneDecodedImagesFirst WRITE setMemoryCachePruneDecodedImagesFirst)
     Q_PROPERTY(QString outputEncoding READ outputEncoding WRITE setOutputEncoding)
     Q_PROPERTY(QString proxyType READ proxyType WRITE setProxyType)
     Q_PROPERTY(QString proxy READ proxy WRITE setProxy)
     Q_PROPERTY(QString proxyAuth READ proxyAuth WRITE setProxyAuth)
     Q_PROPERTY(QString scriptEncoding READ scriptEncoding WRITE setScriptEncoding)
+    Q_PROPERTY(bool scriptCacheEnabled READ scriptCacheEnabled WRITE setScriptCacheEnabled)
+    Q_PROPERTY(QString scriptCachePath READ scriptCachePath WRITE setScriptCachePath)
+    Q_PROPERTY(int scriptParseCacheSize READ scriptParseCacheSize WRITE setScriptParseCacheSize)
     Q_PROPERTY(bool webSecurityEnabled READ webSecurityEnabled WRITE setWebSecurityEnabled)
     Q_PROPERTY(QString offlineStoragePath READ offlineStoragePath WRITE setOfflineStoragePath)
     Q_PROPERTY(int offlineStorageDefaultQuota READ offlineStorageDefaultQuota WRITE setOfflineStorageDefaultQuota)
@@ -97,6 +121,69 @@ public:
     bool localToRemoteUrlAccessEnabled() const;
     void setLocalToRemoteUrlAccessEnabled(const bool value);
 
+    int imageDecodingThreads() const;
+    void setImageDecodingThreads(const int value);
+
+    int maxConnectionsPerHost() const;
+    void setMaxConnectionsPerHost(const int value);
+
+    bool httpPipeliningEnabled() const;
+    void setHttpPipeliningEnabled(const bool value);
+
+    int httpPipelineDepth() const;
+    void setHttpPipelineDepth(const int value);
+
+    bool sharedConnectionsEnabled() const;
+    void setSharedConnectionsEnabled(const bool value);
+
+    int dnsCacheSize() const;
+    void setDnsCacheSize(const int value);
+
+    int dnsCacheTtl() const;
+    void setDnsCacheTtl(const int value);
+
+    QString dnsCacheFile() const;
+    void setDnsCacheFile(const QString &value);
+
+    QString networkArchive() const;
+    void setNetworkArchive(const QString &value);
+
+    QString networkArchiveMode() const;
+    void setNetworkArchiveMode(const QString &value);
+
+    bool dnsPrefetchEnabled() const;
+    void setDnsPrefetchEnabled(const bool value);
+
+    QString fontSnapshotFile() const;
+    void setFontSnapshotFile(const QString &value);
+
+    QString fontsDir() const;
+    void setFontsDir(const QString &value);
+
+    int glyphCacheSize() const;
+    void setGlyphCacheSize(const int value);
+
+    qreal devicePixelRatio() const;
+    void setDevicePixelRatio(const qreal value);
+
+    int dpi() const;
+    void setDpi(const int value);
+
+    QString traceFile() const;
+    void setTraceFile(const QString &value);
+
+    int memoryCacheSize() const;
+    void setMemoryCacheSize(const int value);
+
+    int memoryCacheMaxDeadSize() const;
+    void setMemoryCacheMaxDeadSize(const int value);
+
+    int memoryCacheMinDeadSize() const;
+    void setMemoryCacheMinDeadSize(const int value);
+
+    bool memoryCachePruneDecodedImagesFirst() const;
+    void setMemoryCachePruneDecodedImagesFirst(const bool value);
+
     QString outputEncoding() const;
     void setOutputEncoding(const QString &value);
 
@@ -121,6 +208,15 @@ public:
     QString scriptEncoding() const;
     void setScriptEncoding(const QString &value);
 
+    bool scriptCacheEnabled() const;
+    void setScriptCacheEnabled(const bool value);
+
+    QString scriptCachePath() const;
+    void setScriptCachePath(const QString &value);
+
+    int scriptParseCacheSize() const;
+    void setScriptParseCacheSize(const int value);
+
     QString scriptFile() const;
     void setScriptFile(const QString &value);
 
@@ -195,6 +291,27 @@ private:
     int m_maxDiskCacheSize;
     bool m_ignoreSslErrors;
     bool m_localToRemoteUrlAccessEnabled;
+    int m_imageDecodingThreads;
+    int m_maxConnectionsPerHost;
+    bool m_httpPipeliningEnabled;
+    int m_httpPipelineDepth;
+    bool m_sharedConnectionsEnabled;
+    int m_dnsCacheSize;
+    int m_dnsCacheTtl;
+    QString m_dnsCacheFile;
+    QString m_networkArchive;
+    QString m_networkArchiveMode;
+    bool m_dnsPrefetchEnabled;
+    QString m_fontSnapshotFile;
+    QString m_fontsDir;
+    int m_glyphCacheSize;
+    qreal m_devicePixelRatio;
+    int m_dpi;
+    QString m_traceFile;
+    int m_memoryCacheSize;
+    int m_memoryCacheMaxDeadSize;
+    int m_memoryCacheMinDeadSize;
+    bool m_memoryCachePruneDecodedImagesFirst;
     QString m_outputEncoding;
     QString m_proxyType;
     QString m_proxyHost;
@@ -203,6 +320,9 @@ private:
     QString m_proxyAuthPass;
     QStringList m_scriptArgs;
     QString m_scriptEncoding;
+    bool m_scriptCacheEnabled;
+    QString m_scriptCachePath;
+    int m_scriptParseCacheSize;
     QString m_scriptFile;
     QString m_unknownOption;
     bool m_versionFlag;
@@ -65,6 +65,11 @@
 #define PAGE_SETTINGS_WEB_SECURITY_ENABLED  "webSecurityEnabled"
 #define PAGE_SETTINGS_JS_CAN_OPEN_WINDOWS   "javascriptCanOpenWindows"
 #define PAGE_SETTINGS_JS_CAN_CLOSE_WINDOWS  "javascriptCanCloseWindows"
+#define PAGE_SETTINGS_NETWORK_IDLE_TIMEOUT  "networkIdleTimeout"
+#define PAGE_SETTINGS_NETWORK_IDLE_INFLIGHT "networkIdleInflight"
+#define PAGE_SETTINGS_RENDER_IDLE_TIMEOUT   "renderIdleTimeout"
+#define PAGE_SETTINGS_SCRIPT_TIMEOUT        "scriptTimeoutMs"
+#define PAGE_SETTINGS_SCRIPT_CPU_BUDGET     "scriptCpuBudgetMs"
 
 #define DEFAULT_WEBDRIVER_CONFIG            "127.0.0.1:8910"
 
@@ -30,11 +30,18 @@
 #include "csconverter.h"
 
 #include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryFile>
 #include <QWebFrame>
+#include <QWebPage>
 
 #include "utils.h"
 #include "terminal.h"
 
+#define COFFEE_SCRIPT_COMPILER ":/coffee-script/extras/coffee-script.js"
+
 static CSConverter *csconverter_instance = 0;
 
 CSConverter *CSConverter::instance()
@@ -47,18 +54,94 @@ CSConverter *CSConverter::instance()
 
 CSConverter::CSConverter()
     : QObject(QCoreApplication::instance())
+    , m_webPage(0)
 {
-    m_webPage.mainFrame()->evaluateJavaScript(
-        Utils::readResourceFileUtf8(":/coffee-script/extras/coffee-script.js"),
-        QString("phantomjs://coffee-script/extras/coffee-script.js")
-    );
-    m_webPage.mainFrame()->addToJavaScriptWindowObject("converter", this);
+}
+
+QWebPage *CSConverter::webPage()
+{
+    // Loading the compiler is most of the cost of a conversion: only pay
+    // for it once a script is not found in the cache
+    if (!m_webPage) {
+        m_webPage = new QWebPage(this);
+        m_webPage->mainFrame()->evaluateJavaScript(
+            Utils::readResourceFileUtf8(COFFEE_SCRIPT_COMPILER),
+            QString("phantomjs://coffee-script/extras/coffee-script.js")
+        );
+        m_webPage->mainFrame()->addToJavaScriptWindowObject("converter", this);
+    }
+    return m_webPage;
+}
+
+void CSConverter::setCacheDirectory(const QString &path)
+{
+    m_cacheDirectory = path;
+    if (!m_cacheDirectory.isEmpty())
+        QDir().mkpath(m_cacheDirectory);
+}
+
+QString CSConverter::cacheDirectory() const
+{
+    return m_cacheDirectory;
+}
+
+QByteArray CSConverter::cacheKey(const QString &script)
+{
+    // Scripts compiled by another version of the compiler are not reused
+    if (m_compilerHash.isEmpty()) {
+        QFile compiler(COFFEE_SCRIPT_COMPILER);
+        if (compiler.open(QFile::ReadOnly))
+            m_compilerHash = QCryptographicHash::hash(compiler.readAll(), QCryptographicHash::Sha1);
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(m_compilerHash);
+    hash.addData(script.toUtf8());
+    return hash.result().toHex();
+}
+
+QString CSConverter::readCachedScript(const QByteArray &key) const
+{
+    if (m_cacheDirectory.isEmpty())
+        return QString();
+
+    QFile file(m_cacheDirectory + '/' + key + ".js");
+    if (!file.open(QFile::ReadOnly))
+        return QString();
+    return QString::fromUtf8(file.readAll());
+}
+
+void CSConverter::writeCachedScript(const QByteArray &key, const QString &compiled) const
+{
+    if (m_cacheDirectory.isEmpty())
+        return;
+
+    // Write to a temporary file first, so that another process never reads
+    // a partially written entry
+    QTemporaryFile file(m_cacheDirectory + '/' + key + ".XXXXXX");
+    if (!file.open())
+        return;
+    file.write(compiled.toUtf8());
+    file.close();
+    if (file.rename(m_cacheDirectory + '/' + key + ".js"))
+        file.setAutoRemove(false);
 }
 
 QVariant CSConverter::convert(const QString &script)
 {
+    const QByteArray key = cacheKey(script);
+
+    QString compiled = m_compiled.value(key);
+    if (compiled.isNull()) {
+        compiled = readCachedScript(key);
+        if (!compiled.isNull())
+            m_compiled.insert(key, compiled);
+    }
+    if (!compiled.isNull())
+        return QVariantList() << true << compiled;
+
     setProperty("source", script);
-    QVariant result = m_webPage.mainFrame()->evaluateJavaScript(
+    QVariant result = webPage()->mainFrame()->evaluateJavaScript(
         "try {" \
         "    [true, this.CoffeeScript.compile(converter.source)];" \
         "} catch (error) {" \
@@ -66,5 +149,13 @@ QVariant CSConverter::convert(const QString &script)
         "}",
         QString()
     );
+
+    // Only successful compilations are cached: errors are reported again
+    const QVariantList list = result.toList();
+    if (list.count() == 2 && list.at(0).toBool()) {
+        compiled = list.at(1).toString();
+        m_compiled.insert(key, compiled);
+        writeCachedScript(key, compiled);
+    }
     return result;
 }
@@ -30,8 +30,11 @@
 #ifndef CSCONVERTER_H
 #define CSCONVERTER_H
 
+#include <QHash>
 #include <QObject>
-#include <QWebPage>
+#include <QVariant>
+
+class QWebPage;
 
 class CSConverter: public QObject
 {
@@ -39,9 +42,22 @@ public:
     static CSConverter *instance();
     QVariant convert(const QString &script);
 
+    // Keeps the compiled scripts in this directory between runs.
+    // Caching on disk is off while it is empty.
+    void setCacheDirectory(const QString &path);
+    QString cacheDirectory() const;
+
 private:
     CSConverter();
-    QWebPage m_webPage;
+    QByteArray cacheKey(const QString &script);
+    QString readCachedScript(const QByteArray &key) const;
+    void writeCachedScript(const QByteArray &key, const QString &compiled) const;
+    QWebPage *webPage();
+
+    QWebPage *m_webPage;
+    QByteArray m_compilerHash;
+    QString m_cacheDirectory;
+    QHash<QByteArray, QString> m_compiled;
 };
 
 #endif // CSCONVERTER_H
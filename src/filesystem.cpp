@@ -35,6 +35,8 @@
 #include <QDebug>
 #include <QDateTime>
 
+#include <limits.h>
+
 // File
 // public:
 File::File(QFile *openfile, QTextCodec *codec, QObject *parent) :
@@ -53,36 +55,35 @@ File::~File()
     this->close();
 }
 
-//NOTE: for binary files we want to use QString instead of QByteArray as the
-//      latter is not really useable in javascript and e.g. window.btoa expects a string
-//      and we need special code required since fromAsci() would stop as soon as it
-//      encounters \0 or similar
+//NOTE: for binary files read() and write() use a QString holding one Latin-1
+//      character per byte, as QByteArray used to be unusable in javascript and
+//      e.g. window.btoa expects a string. readBytes() and writeBytes() hand the
+//      data over as a byte array instead.
 
 // public slots:
 QString File::read(const QVariant &n)
 {
-    // Default to 1024 (used when n is "null")
-    qint64 bytesToRead = 1024;
-
-    // If parameter can be converted to a qint64, do so and use that value instead
-    if (n.canConvert(QVariant::LongLong)) {
-        bytesToRead = n.toLongLong();
-    }
-
-    const bool isReadAll = 0 > bytesToRead;
-
     if ( !m_file->isReadable() ) {
         qDebug() << "File::read - " << "Couldn't read:" << m_file->fileName();
         return QString();
     }
-    if ( m_file->isWritable() ) {
-        // make sure we write everything to disk before reading
-        flush();
-    }
     if ( m_fileStream ) {
+        // Default to 1024 (used when n is "null")
+        qint64 bytesToRead = 1024;
+
+        // If parameter can be converted to a qint64, do so and use that value instead
+        if (n.canConvert(QVariant::LongLong)) {
+            bytesToRead = n.toLongLong();
+        }
+
+        if ( m_file->isWritable() ) {
+            // make sure we write everything to disk before reading
+            flush();
+        }
+
         // text file
         QString ret;
-        if (isReadAll) {
+        if (0 > bytesToRead) {
             // This code, for some reason, reads the whole file from 0 to EOF,
             // and then resets to the position the file was at prior to reading
             const qint64 pos = m_fileStream->pos();
@@ -95,22 +96,8 @@ QString File::read(const QVariant &n)
         return ret;
     } else {
         // binary file
-        QByteArray data;
-        if (isReadAll) {
-            // This code, for some reason, reads the whole file from 0 to EOF,
-            // and then resets to the position the file was at prior to reading
-            const qint64 pos = m_file->pos();
-            m_file->seek(0);
-            data = m_file->readAll();
-            m_file->seek(pos);
-        } else {
-            data = m_file->read(bytesToRead);
-        }
-        QString ret(data.size());
-        for(int i = 0; i < data.size(); ++i) {
-            ret[i] = data.at(i);
-        }
-        return ret;
+        const QByteArray data = _readRaw(n);
+        return QString::fromLatin1(data.constData(), data.size());
     }
 }
 
@@ -129,14 +116,37 @@ bool File::write(const QString &data)
         return true;
     } else {
         // binary file
-        QByteArray bytes(data.size(), Qt::Uninitialized);
-        for(int i = 0; i < data.size(); ++i) {
-            bytes[i] = data.at(i).toAscii();
-        }
-        return m_file->write(bytes);
+        return m_file->write(data.toLatin1());
     }
 }
 
+QByteArray File::readBytes(const QVariant &n)
+{
+    if ( !m_file->isReadable() ) {
+        qDebug() << "File::readBytes - " << "Couldn't read:" << m_file->fileName();
+        return QByteArray();
+    }
+    if ( m_fileStream ) {
+        // text file - hand out whatever the codec would encode
+        return m_fileStream->codec()->fromUnicode(read(n));
+    }
+    // binary file
+    return _readRaw(n);
+}
+
+bool File::writeBytes(const QByteArray &data)
+{
+    if ( !m_file->isWritable() ) {
+        qDebug() << "File::writeBytes - " << "Couldn't write:" << m_file->fileName();
+        return false;
+    }
+    if ( m_fileStream ) {
+        // make sure text written so far lands before the raw bytes
+        m_fileStream->flush();
+    }
+    return m_file->write(data) == data.size();
+}
+
 bool File::seek(const qint64 pos)
 {
     if (m_fileStream) {
@@ -266,6 +276,111 @@ bool File::_isUnbuffered() const
     return m_file->openMode() & QIODevice::Unbuffered;
 }
 
+QByteArray File::_readRaw(const QVariant &n)
+{
+    // Default to 1024 (used when n is "null")
+    qint64 bytesToRead = 1024;
+
+    // If parameter can be converted to a qint64, do so and use that value instead
+    if (n.canConvert(QVariant::LongLong)) {
+        bytesToRead = n.toLongLong();
+    }
+
+    if ( m_file->isWritable() ) {
+        // make sure we write everything to disk before reading
+        flush();
+    }
+
+    const bool isReadAll = 0 > bytesToRead;
+    const qint64 pos = m_file->pos();
+    if (isReadAll) {
+        if (m_file->isSequential())
+            return m_file->readAll();
+
+        // This code, for some reason, reads the whole file from 0 to EOF,
+        // and then resets to the position the file was at prior to reading
+        m_file->seek(0);
+        bytesToRead = m_file->size();
+    } else if (!m_file->isSequential()) {
+        bytesToRead = qMin(bytesToRead, qMax(qint64(0), m_file->size() - pos));
+    }
+
+    // Sizes stay 64 bit up to here, where QIODevice::read() and readAll()
+    // would wrap them around into the int size of a QByteArray
+    if (bytesToRead > qint64(INT_MAX)) {
+        qWarning() << "File::read - " << "Only" << INT_MAX << "of" << bytesToRead
+                   << "bytes fit in a single read:" << m_file->fileName();
+        bytesToRead = INT_MAX;
+    }
+
+    QByteArray data(int(bytesToRead), Qt::Uninitialized);
+    const qint64 bytesRead = m_file->read(data.data(), bytesToRead);
+    data.resize(int(qMax(qint64(0), bytesRead)));
+
+    if (isReadAll) {
+        m_file->seek(pos);
+    }
+    return data;
+}
+
+
+// MappedFile
+// public:
+MappedFile::MappedFile(QFile *file, uchar *data, QObject *parent) :
+    QObject(parent),
+    m_file(file),
+    m_data(data),
+    m_size(file->size())
+{
+}
+
+MappedFile::~MappedFile()
+{
+    this->close();
+}
+
+qint64 MappedFile::size() const
+{
+    return m_data ? m_size : 0;
+}
+
+// public slots:
+QByteArray MappedFile::readBytes(const qint64 offset, const qint64 length) const
+{
+    if ( !m_data || offset < 0 || offset > m_size ) {
+        return QByteArray();
+    }
+    const qint64 available = m_size - offset;
+    qint64 count = (length < 0 || length > available) ? available : length;
+    // Passed on as an int, where a negative size would mean up to a '\0'
+    if (count > qint64(INT_MAX)) {
+        qWarning() << "MappedFile::readBytes - " << "Only" << INT_MAX << "of" << count
+                   << "bytes fit in a single read:" << m_file->fileName();
+        count = INT_MAX;
+    }
+    return QByteArray(reinterpret_cast<const char *>(m_data + offset), int(count));
+}
+
+QString MappedFile::read(const qint64 offset, const qint64 length) const
+{
+    const QByteArray data = readBytes(offset, length);
+    return QString::fromLatin1(data.constData(), data.size());
+}
+
+void MappedFile::close()
+{
+    if ( m_file ) {
+        if ( m_data ) {
+            m_file->unmap(m_data);
+            m_data = 0;
+        }
+        m_file->close();
+        delete m_file;
+        m_file = NULL;
+    }
+    deleteLater();
+}
+
 
 // FileSystem
 // public:
@@ -520,6 +635,29 @@ QObject *FileSystem::_open(const QString &path, const QVariantMap &opts) const
     return new File(file, codec);
 }
 
+QObject *FileSystem::_mmap(const QString &path) const
+{
+    QFile *file = new QFile(path);
+    if ( !file->open(QFile::ReadOnly) ) {
+        delete file;
+        qDebug() << "FileSystem::mmap - " << "Couldn't be opened:" << path;
+        return 0;
+    }
+
+    // Mapping an empty file fails, but there is nothing to read anyway
+    uchar *data = 0;
+    if ( file->size() > 0 ) {
+        data = file->map(0, file->size());
+        if ( !data ) {
+            qDebug() << "FileSystem::mmap - " << "Couldn't be mapped:" << path << file->errorString();
+            delete file;
+            return 0;
+        }
+    }
+
+    return new MappedFile(file, data);
+}
+
 bool FileSystem::_remove(const QString &path) const
 {
     return QFile::remove(path);
@@ -54,6 +54,16 @@ public slots:
      */
     QString read(const QVariant &n = -1);
     bool write(const QString &data);
+    /**
+     * Binary counterparts of read()/write(): data crosses into JavaScript
+     * as a byte array instead of a one-char-per-byte string. A single call
+     * returns at most 2 GB (the size limit of a byte array): larger files
+     * are read in parts.
+     *
+     * @param n Number of bytes to read (a negative value means read up to EOF)
+     */
+    QByteArray readBytes(const QVariant &n = -1);
+    bool writeBytes(const QByteArray &data);
 
     bool seek(const qint64 pos);
 
@@ -69,12 +79,47 @@ public slots:
 
 private:
     bool _isUnbuffered() const;
+    QByteArray _readRaw(const QVariant &n);
 
     QFile *m_file;
     QTextStream *m_fileStream;
 };
 
 
+/**
+ * Read-only, memory mapped view of a file.
+ * Only the requested ranges are copied out of the mapping, so large files
+ * can be inspected without reading them into memory first.
+ */
+class MappedFile : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(qint64 size READ size)
+
+public:
+    // takes ownership of @p file, which must be open for reading
+    MappedFile(QFile *file, uchar *data, QObject *parent = 0);
+    virtual ~MappedFile();
+
+    qint64 size() const;
+
+public slots:
+    /**
+     * @param offset Position of the first byte to return
+     * @param length Number of bytes to return (a negative value means up to the end)
+     */
+    QByteArray readBytes(const qint64 offset = 0, const qint64 length = -1) const;
+    QString read(const qint64 offset = 0, const qint64 length = -1) const;
+
+    void close();
+
+private:
+    QFile *m_file;
+    uchar *m_data;
+    qint64 m_size;
+};
+
+
 class FileSystem : public QObject
 {
     Q_OBJECT
@@ -107,6 +152,8 @@ public slots:
     // 'readRaw(path, options)' implemented in "filesystem-shim.js"
     // 'write(path, mode|options)' implemented in the "filesystem-shim.js"
     // 'writeRaw(path, mode|options)' implemented in the "filesystem-shim.js"
+    // 'mmap(path)' implemented in "filesystem-shim.js" using '_mmap(path)'
+    QObject *_mmap(const QString &path) const;
     // 'remove(path)' implemented in "filesystem-shim.js" using '_remove(path)'
     bool _remove(const QString &path) const;
     // 'copy(source, destination)' implemented in "filesystem-shim.js" using '_copy(source, destination)'
@@ -138,6 +138,24 @@ exports.write = function (path, content, modeOrOpts) {
     f.close();
 };
 
+/** Map a file into memory for read-only access.
+ * It will throw an exception if it fails.
+ *
+ * The returned object exposes `size`, `readBytes(offset, length)`,
+ * `read(offset, length)` and `close()`. Only the requested ranges are
+ * copied out of the mapping.
+ *
+ * @param path Path of the file to map
+ * @return "mapped file" object
+ */
+exports.mmap = function (path) {
+    var mapped = exports._mmap(path);
+    if (mapped) {
+        return mapped;
+    }
+    throw "Unable to map file '" + path + "'";
+};
+
 /** Return the size of a file, in bytes.
  * It will throw an exception if it fails.
  *
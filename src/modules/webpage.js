@@ -262,8 +262,71 @@ function decorateNewPage(opts, page) {
 
     definePageSignalHandler(page, handlers, "onClosing", "closing");
 
-    // Private callback for "page.open()"
+    definePageSignalHandler(page, handlers, "onNetworkIdle", "networkIdle");
+
+    definePageSignalHandler(page, handlers, "onRenderIdle", "renderIdle");
+
+    definePageSignalHandler(page, handlers, "onScriptTimeout", "scriptTimeout");
+
+    // Private callbacks for "page.open()"
     definePageSignalHandler(page, handlers, "_onPageOpenFinished", "loadFinished");
+    definePageSignalHandler(page, handlers, "_onPageOpenNetworkIdle", "networkIdle");
+    definePageSignalHandler(page, handlers, "_onPageOpenRenderIdle", "renderIdle");
+
+    /**
+     * Connects the callback of "page.open()", to be invoked only once.
+     * By default it fires when the page has loaded. With "waitUntil" set to
+     * "networkidle" or "renderidle" in the settings passed to "page.open()",
+     * a successful load also waits for "onNetworkIdle" or "onRenderIdle".
+     * A page that never settles (e.g. a looping animation) still gets the
+     * callback "waitTimeout" ms (default 30000) after it has loaded.
+     */
+    function setPageOpenCallback(thisPage, op, callback) {
+        var waitUntil = (op !== null && typeof op === "object" && op.waitUntil) || "load",
+            waitTimeout = (op !== null && typeof op === "object" && op.waitTimeout) || 30000,
+            idleHandlerName,
+            loadArguments = null,
+            idle = false;
+
+        // Drop the callbacks of a previous "page.open()" that never completed
+        thisPage._onPageOpenNetworkIdle = null;
+        thisPage._onPageOpenRenderIdle = null;
+        clearTimeout(thisPage._pageOpenWaitTimer);
+
+        if (waitUntil === "networkidle") {
+            idleHandlerName = "_onPageOpenNetworkIdle";
+        } else if (waitUntil === "renderidle") {
+            idleHandlerName = "_onPageOpenRenderIdle";
+        } else if (waitUntil !== "load") {
+            throw "Unknown value of waitUntil: " + waitUntil;
+        }
+
+        function finish() {
+            thisPage._onPageOpenFinished = null; //< Disconnect callbacks (should fire only once)
+            if (idleHandlerName) {
+                thisPage[idleHandlerName] = null;
+            }
+            clearTimeout(thisPage._pageOpenWaitTimer);
+            callback.apply(thisPage, loadArguments); //< Invoke the actual callback
+        }
+
+        thisPage._onPageOpenFinished = function(status) {
+            loadArguments = arguments;
+            if (!idleHandlerName || idle || status !== "success") {
+                finish();
+            } else {
+                thisPage._pageOpenWaitTimer = setTimeout(finish, waitTimeout);
+            }
+        };
+        if (idleHandlerName) {
+            thisPage[idleHandlerName] = function() {
+                idle = true;
+                if (loadArguments !== null) {
+                    finish();
+                }
+            };
+        }
+    }
 
     phantom.__defineErrorSignalHandler__(page, page, handlers);
 
@@ -276,20 +339,14 @@ function decorateNewPage(opts, page) {
             this.openUrl(url, 'get', this.settings);
             return;
         } else if (arguments.length === 2 && typeof arg1 === 'function') {
-            this._onPageOpenFinished = function() {
-                thisPage._onPageOpenFinished = null; //< Disconnect callback (should fire only once)
-                arg1.apply(thisPage, arguments);     //< Invoke the actual callback
-            }
+            setPageOpenCallback(this, null, arg1);
             this.openUrl(url, 'get', this.settings);
             return;
         } else if (arguments.length === 2) {
             this.openUrl(url, arg1, this.settings);
             return;
         } else if (arguments.length === 3 && typeof arg2 === 'function') {
-            this._onPageOpenFinished = function() {
-                thisPage._onPageOpenFinished = null; //< Disconnect callback (should fire only once)
-                arg2.apply(thisPage, arguments);     //< Invoke the actual callback
-            }
+            setPageOpenCallback(this, arg1, arg2);
             this.openUrl(url, arg1, this.settings);
             return;
         } else if (arguments.length === 3) {
@@ -299,20 +356,14 @@ function decorateNewPage(opts, page) {
             }, this.settings);
             return;
         } else if (arguments.length === 4) {
-            this._onPageOpenFinished = function() {
-                thisPage._onPageOpenFinished = null; //< Disconnect callback (should fire only once)
-                arg3.apply(thisPage, arguments);     //< Invoke the actual callback
-            }
+            setPageOpenCallback(this, null, arg3);
             this.openUrl(url, {
                 operation: arg1,
                 data: arg2
             }, this.settings);
             return;
         } else if (arguments.length === 5) {
-            this._onPageOpenFinished = function() {
-                thisPage._onPageOpenFinished = null; //< Disconnect callback (should fire only once)
-                arg4.apply(thisPage, arguments);     //< Invoke the actual callback
-            }
+            setPageOpenCallback(this, null, arg4);
             this.openUrl(url, {
                 operation: arg1,
                 data: arg2,
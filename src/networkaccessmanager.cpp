@@ -31,21 +31,49 @@
 #include <QAuthenticator>
 #include <QDateTime>
 #include <QDesktopServices>
+#include <QNetworkCookie>
 #include <QNetworkDiskCache>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QSslSocket>
 #include <QSslCertificate>
 #include <QRegExp>
+#include <QWebSettings>
+#include <QtNetwork/private/qnetworktimestamp_p.h>
 
 #include "phantom.h"
 #include "config.h"
 #include "cookiejar.h"
 #include "networkaccessmanager.h"
+#include "networkarchive.h"
+#include "networkthrottle.h"
 
 // 10 MB
 const qint64 MAX_REQUEST_POST_BODY_SIZE = 10 * 1000 * 1000;
 
+static const char *timingPhases[] = {
+    "dnsStart", "dnsEnd",
+    "connectStart", "connectEnd",
+    "sslStart", "sslEnd",
+    "sendStart", "sendEnd",
+    "responseStart", "responseEnd"
+};
+
+// Milliseconds from the request to each phase of it, -1 for the phases that
+// did not happen (e.g. there is no lookup nor connect on a reused connection)
+static QVariantMap requestTimings(QNetworkReply *reply, qint64 requestStart)
+{
+    const QVariantMap phases = reply->attribute(QNetworkRequest::HttpTimingsAttribute).toMap();
+    const double start = requestStart / 1000000.0;
+
+    QVariantMap timings;
+    for (size_t i = 0; i < sizeof(timingPhases) / sizeof(timingPhases[0]); ++i) {
+        const double time = phases.value(timingPhases[i], -1.0).toDouble();
+        timings[timingPhases[i]] = time < 0 ? -1.0 : time - start;
+    }
+    return timings;
+}
+
 static const char *toString(QNetworkAccessManager::Operation op)
 {
     const char *str = 0;
@@ -109,16 +137,32 @@ void JsNetworkRequest::changeUrl(const QString& address)
     }
 }
 
+static int totalPendingRequests = 0;
+
+Q_GLOBAL_STATIC(PendingRequestNotifier, pendingRequestNotifier)
+
+PendingRequestNotifier *PendingRequestNotifier::instance()
+{
+    return pendingRequestNotifier();
+}
+
+void PendingRequestNotifier::notify(int count)
+{
+    emit totalPendingRequestCountChanged(count);
+}
+
 // public:
 NetworkAccessManager::NetworkAccessManager(QObject *parent, const Config *config)
     : QNetworkAccessManager(parent)
     , m_ignoreSslErrors(config->ignoreSslErrors())
+    , m_httpPipelining(config->httpPipeliningEnabled())
     , m_authAttempts(0)
     , m_maxAuthAttempts(3)
     , m_resourceTimeout(0)
     , m_idCounter(0)
     , m_networkDiskCache(0)
     , m_sslConfiguration(QSslConfiguration::defaultConfiguration())
+    , m_throttle(new NetworkThrottle(this))
 {
     setCookieJar(CookieJar::instance());
 
@@ -160,6 +204,27 @@ NetworkAccessManager::NetworkAccessManager(QObject *parent, const Config *config
     connect(this, SIGNAL(finished(QNetworkReply*)), SLOT(handleFinished(QNetworkReply*)));
 }
 
+NetworkAccessManager::~NetworkAccessManager()
+{
+    if (m_ids.isEmpty())
+        return;
+
+    // Requests dropped with the page can be the last ones another page is
+    // waiting on, exactly as if they had finished
+    totalPendingRequests -= m_ids.count();
+    PendingRequestNotifier::instance()->notify(totalPendingRequests);
+}
+
+int NetworkAccessManager::pendingRequestCount() const
+{
+    return m_ids.count();
+}
+
+int NetworkAccessManager::totalPendingRequestCount()
+{
+    return totalPendingRequests;
+}
+
 void NetworkAccessManager::setUserName(const QString &userName)
 {
     m_userName = userName;
@@ -190,6 +255,27 @@ QVariantMap NetworkAccessManager::customHeaders() const
     return m_customHeaders;
 }
 
+void NetworkAccessManager::setNetworkConditions(const QVariantMap &conditions)
+{
+    m_throttle->setLatency(conditions.value("latencyMs").toInt());
+    m_throttle->setDownloadRate(conditions.value("downloadKbps").toInt());
+    m_throttle->setUploadRate(conditions.value("uploadKbps").toInt());
+    m_throttle->setPacketLoss(conditions.value("packetLossPercent").toInt());
+    // Requests to anything but local files fail as if there was no network
+    setNetworkAccessible(conditions.value("offline").toBool() ? NotAccessible : Accessible);
+}
+
+QVariantMap NetworkAccessManager::networkConditions() const
+{
+    QVariantMap conditions;
+    conditions["latencyMs"] = m_throttle->latency();
+    conditions["downloadKbps"] = m_throttle->downloadRate();
+    conditions["uploadKbps"] = m_throttle->uploadRate();
+    conditions["packetLossPercent"] = m_throttle->packetLoss();
+    conditions["offline"] = networkAccessible() == NotAccessible;
+    return conditions;
+}
+
 void NetworkAccessManager::setCookieJar(QNetworkCookieJar *cookieJar)
 {
     QNetworkAccessManager::setCookieJar(cookieJar);
@@ -217,15 +303,23 @@ QNetworkReply *NetworkAccessManager::createRequest(Operation op, const QNetworkR
     QByteArray url = req.url().toEncoded();
     QByteArray postData;
 
+    // The body of PUT and custom requests tells them apart in the network
+    // archive as much as the one of a POST
+    if (outgoingData) postData = outgoingData->peek(MAX_REQUEST_POST_BODY_SIZE);
+
     // http://code.google.com/p/phantomjs/issues/detail?id=337
     if (op == QNetworkAccessManager::PostOperation) {
-        if (outgoingData) postData = outgoingData->peek(MAX_REQUEST_POST_BODY_SIZE);
         QString contentType = req.header(QNetworkRequest::ContentTypeHeader).toString();
         if (contentType.isEmpty()) {
             req.setHeader(QNetworkRequest::ContentTypeHeader, "application/x-www-form-urlencoded");
         }
     }
 
+    // Qt only pipelines requests that explicitly allow it
+    if (m_httpPipelining) {
+        req.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+    }
+
     // set custom HTTP headers
     QVariantMap::const_iterator i = m_customHeaders.begin();
     while (i != m_customHeaders.end()) {
@@ -254,8 +348,45 @@ QNetworkReply *NetworkAccessManager::createRequest(Operation op, const QNetworkR
     JsNetworkRequest jsNetworkRequest(&req, this);
     emit resourceRequested(data, &jsNetworkRequest);
 
-    // Pass duty to the superclass - Nothing special to do here (yet?)
-    QNetworkReply *reply = QNetworkAccessManager::createRequest(op, req, outgoingData);
+    const qint64 requestStart = qt_network_timestamp();
+    const qint64 uploadSize = outgoingData ? qMax(qint64(0), outgoingData->size()) : 0;
+
+    // Local content does not go through the network, nor in the archive
+    const QString scheme = req.url().scheme().toLower();
+    const bool overNetwork = scheme == "http" || scheme == "https" || scheme == "ftp";
+    NetworkArchive *archive = NetworkArchive::instance();
+
+    QNetworkReply *reply;
+    bool wrapped = false;
+    if (overNetwork && archive->mode() == NetworkArchive::Replay) {
+        // Served from the archive without any socket
+        reply = new ReplayedNetworkReply(op, req, archive, NetworkArchive::key(toString(op), req.url(), postData), this);
+        const QList<QNetworkCookie> cookies = reply->header(QNetworkRequest::SetCookieHeader).value<QList<QNetworkCookie> >();
+        if (!cookies.isEmpty()) {
+            cookieJar()->setCookiesFromUrl(cookies, req.url());
+        }
+        wrapped = true;
+    } else {
+        // Pass duty to the superclass - Nothing special to do here (yet?)
+        reply = QNetworkAccessManager::createRequest(op, req, outgoingData);
+
+        if (overNetwork && archive->mode() == NetworkArchive::Record) {
+            reply = new RecordingNetworkReply(reply, archive, NetworkArchive::key(toString(op), req.url(), postData));
+            wrapped = true;
+        }
+    }
+
+    // Emulate the network conditions of the page. Synchronous requests have
+    // to be done on return.
+    if (m_throttle->isActive() && overNetwork && !req.attribute(QNetworkRequest::SynchronousRequestAttribute).toBool()) {
+        reply = new ThrottledNetworkReply(reply, m_throttle, uploadSize);
+        wrapped = true;
+    }
+
+    // The manager only reports the replies it created itself as finished
+    if (wrapped) {
+        connect(reply, SIGNAL(finished()), this, SLOT(handleWrappedFinished()));
+    }
 
     // reparent jsNetworkRequest to make sure that it will be destroyed with QNetworkReply
     jsNetworkRequest.setParent(reply);
@@ -274,11 +405,24 @@ QNetworkReply *NetworkAccessManager::createRequest(Operation op, const QNetworkR
     }
 
     m_ids[reply] = m_idCounter;
+    m_requestStarts[reply] = requestStart;
+    ++totalPendingRequests;
+    PendingRequestNotifier::instance()->notify(totalPendingRequests);
+    if (QWebSettings::isTracing()) {
+        m_traceStarts[reply] = QWebSettings::traceTimestamp();
+    }
 
     connect(reply, SIGNAL(readyRead()), this, SLOT(handleStarted()));
     connect(reply, SIGNAL(sslErrors(const QList<QSslError> &)), this, SLOT(handleSslErrors(const QList<QSslError> &)));
     connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(handleNetworkError()));
 
+    emit pendingRequestCountChanged(m_ids.count());
+
+    // Synchronous requests are over already: no signal will tell
+    if (reply->isFinished()) {
+        handleFinished(reply);
+    }
+
     return reply;
 }
 
@@ -327,6 +471,7 @@ void NetworkAccessManager::handleStarted()
     data["redirectURL"] = reply->header(QNetworkRequest::LocationHeader);
     data["headers"] = headers;
     data["time"] = QDateTime::currentDateTime();
+    data["timings"] = requestTimings(reply, m_requestStarts.value(reply));
 
     emit resourceReceived(data);
 }
@@ -342,6 +487,13 @@ void NetworkAccessManager::handleFinished(QNetworkReply *reply)
     this->handleFinished(reply, status, statusText);
 }
 
+void NetworkAccessManager::handleWrappedFinished()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    if (reply)
+        handleFinished(reply);
+}
+
 void NetworkAccessManager::provideAuthentication(QNetworkReply *reply, QAuthenticator *authenticator)
 {
     if (m_authAttempts++ < m_maxAuthAttempts)
@@ -352,7 +504,12 @@ void NetworkAccessManager::provideAuthentication(QNetworkReply *reply, QAuthenti
     else
     {
         m_authAttempts = 0;
-        this->handleFinished(reply, 401, "Authorization Required");
+        // Qt asks about the reply it created, which the page may only know
+        // through the replies wrapping it
+        QNetworkReply *wrapper = reply;
+        while (wrapper && !m_ids.contains(wrapper))
+            wrapper = qobject_cast<QNetworkReply*>(wrapper->parent());
+        this->handleFinished(wrapper ? wrapper : reply, 401, "Authorization Required");
         reply->close();
     }
 }
@@ -377,11 +534,31 @@ void NetworkAccessManager::handleFinished(QNetworkReply *reply, const QVariant &
     data["redirectURL"] = reply->header(QNetworkRequest::LocationHeader);
     data["headers"] = headers;
     data["time"] = QDateTime::currentDateTime();
+    data["timings"] = requestTimings(reply, m_requestStarts.value(reply));
+
+    if (m_traceStarts.contains(reply)) {
+        const qint64 start = m_traceStarts.take(reply);
+        if (QWebSettings::isTracing()) {
+            QVariantMap args;
+            args["url"] = data["url"];
+            args["status"] = status;
+            // Requests overlap each other, hence an asynchronous span keyed by the reply
+            QWebSettings::addTraceEvent("network", "NetworkAccessManager::request", start,
+                                        QWebSettings::traceTimestamp() - start, args, quintptr(reply));
+        }
+    }
 
-    m_ids.remove(reply);
+    const bool wasPending = m_ids.remove(reply) > 0;
     m_started.remove(reply);
+    m_requestStarts.remove(reply);
 
     emit resourceReceived(data);
+
+    if (wasPending) {
+        --totalPendingRequests;
+        emit pendingRequestCountChanged(m_ids.count());
+        PendingRequestNotifier::instance()->notify(totalPendingRequests);
+    }
 }
 
 void NetworkAccessManager::handleSslErrors(const QList<QSslError> &errors)
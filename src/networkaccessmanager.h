@@ -40,6 +40,7 @@
 #include <QTimer>
 
 class Config;
+class NetworkThrottle;
 class QNetworkDiskCache;
 class QSslConfiguration;
 
@@ -67,22 +68,47 @@ private:
     QNetworkRequest* m_networkRequest;
 };
 
+// Announces changes of the request count summed over every
+// NetworkAccessManager, including the requests dropped with a closed page
+class PendingRequestNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    static PendingRequestNotifier *instance();
+
+signals:
+    void totalPendingRequestCountChanged(int count);
+
+private:
+    friend class NetworkAccessManager;
+    void notify(int count);
+};
+
 class NetworkAccessManager : public QNetworkAccessManager
 {
     Q_OBJECT
 public:
     NetworkAccessManager(QObject *parent, const Config *config);
+    virtual ~NetworkAccessManager();
     void setUserName(const QString &userName);
     void setPassword(const QString &password);
     void setMaxAuthAttempts(int maxAttempts);
     void setResourceTimeout(int resourceTimeout);
     void setCustomHeaders(const QVariantMap &headers);
     QVariantMap customHeaders() const;
+    void setNetworkConditions(const QVariantMap &conditions);
+    QVariantMap networkConditions() const;
 
     void setCookieJar(QNetworkCookieJar *cookieJar);
 
+    int pendingRequestCount() const;
+    // Requests in flight across all the NetworkAccessManager instances
+    static int totalPendingRequestCount();
+
 protected:
     bool m_ignoreSslErrors;
+    bool m_httpPipelining;
     int m_authAttempts;
     int m_maxAuthAttempts;
     int m_resourceTimeout;
@@ -96,10 +122,12 @@ signals:
     void resourceReceived(const QVariant& data);
     void resourceError(const QVariant& data);
     void resourceTimeout(const QVariant& data);
+    void pendingRequestCountChanged(int count);
 
 private slots:
     void handleStarted();
     void handleFinished(QNetworkReply *reply);
+    void handleWrappedFinished();
     void provideAuthentication(QNetworkReply *reply, QAuthenticator *authenticator);
     void handleSslErrors(const QList<QSslError> &errors);
     void handleNetworkError();
@@ -108,10 +136,13 @@ private slots:
 private:
     QHash<QNetworkReply*, int> m_ids;
     QSet<QNetworkReply*> m_started;
+    QHash<QNetworkReply*, qint64> m_traceStarts;
+    QHash<QNetworkReply*, qint64> m_requestStarts;
     int m_idCounter;
     QNetworkDiskCache* m_networkDiskCache;
     QVariantMap m_customHeaders;
     QSslConfiguration m_sslConfiguration;
+    NetworkThrottle *m_throttle;
 };
 
 #endif // NETWORKACCESSMANAGER_H
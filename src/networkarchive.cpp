@@ -0,0 +1,437 @@
+/*
+  This file is part of the PhantomJS project from Ofi Labs.
+
+  Copyright (C) 2013 execjosh, http://execjosh.blogspot.com
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+  THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "networkarchive.h"
+
+#include <string.h>
+
+#include <QCryptographicHash>
+#include <QNetworkRequest>
+#include <QUrl>
+
+#include "phantom.h"
+
+// "PJNA"
+#define ARCHIVE_MAGIC       0x504a4e41
+#define ARCHIVE_VERSION     1
+// Offset of the index and magic, at the end of a closed archive
+#define ARCHIVE_TRAILER_SIZE    (sizeof(qint64) + sizeof(quint32))
+
+static QDataStream &operator<<(QDataStream &out, const NetworkArchive::Entry &entry)
+{
+    out << qint32(entry.status) << entry.reasonPhrase << qint32(entry.error) << entry.errorString;
+    out << entry.headers << entry.body;
+    return out;
+}
+
+static QDataStream &operator>>(QDataStream &in, NetworkArchive::Entry &entry)
+{
+    qint32 status, error;
+    in >> status >> entry.reasonPhrase >> error >> entry.errorString;
+    in >> entry.headers >> entry.body;
+    entry.status = status;
+    entry.error = error;
+    return in;
+}
+
+// Attributes of the wrapped reply that describe the response
+static bool isResponseAttribute(QNetworkRequest::Attribute attribute)
+{
+    // The zero-copy buffer would hand out the data behind our back
+    return attribute != QNetworkRequest::DownloadBufferAttribute;
+}
+
+
+// NetworkArchive
+// public:
+NetworkArchive *NetworkArchive::instance()
+{
+    static NetworkArchive *singleton = NULL;
+    if (!singleton) {
+        singleton = new NetworkArchive(Phantom::instance());
+    }
+    return singleton;
+}
+
+NetworkArchive::~NetworkArchive()
+{
+    close();
+}
+
+bool NetworkArchive::open(const QString &fileName, Mode mode)
+{
+    close();
+    if (mode == Closed)
+        return true;
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(mode == Record ? QIODevice::WriteOnly | QIODevice::Truncate : QIODevice::ReadOnly))
+        return false;
+
+    m_stream.setDevice(&m_file);
+    m_stream.setVersion(QDataStream::Qt_4_8);
+
+    if (mode == Record) {
+        m_stream << quint32(ARCHIVE_MAGIC) << quint32(ARCHIVE_VERSION);
+    } else {
+        quint32 magic, version;
+        m_stream >> magic >> version;
+        if (m_stream.status() != QDataStream::Ok || magic != ARCHIVE_MAGIC || version != ARCHIVE_VERSION || !readIndex()) {
+            m_stream.setDevice(0);
+            m_file.close();
+            return false;
+        }
+    }
+
+    m_mode = mode;
+    return true;
+}
+
+void NetworkArchive::close()
+{
+    if (m_mode == Record) {
+        const qint64 indexOffset = m_file.pos();
+        m_stream << m_index << indexOffset << quint32(ARCHIVE_MAGIC);
+    }
+
+    m_stream.setDevice(0);
+    m_file.close();
+    m_index.clear();
+    m_mode = Closed;
+}
+
+NetworkArchive::Mode NetworkArchive::mode() const
+{
+    return m_mode;
+}
+
+QByteArray NetworkArchive::key(const QByteArray &method, const QUrl &url, const QByteArray &body)
+{
+    QByteArray key = method + ' ' + url.toEncoded(QUrl::RemoveFragment);
+    if (!body.isEmpty())
+        key += ' ' + QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex();
+    return key;
+}
+
+void NetworkArchive::record(const QByteArray &key, const QNetworkReply *reply, const QByteArray &body)
+{
+    // The first response to a request is the one replayed
+    if (m_mode != Record || m_index.contains(key))
+        return;
+
+    Entry entry;
+    entry.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    entry.reasonPhrase = reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toByteArray();
+    entry.error = reply->error();
+    entry.errorString = reply->errorString();
+    entry.headers = reply->rawHeaderPairs();
+    entry.body = body;
+
+    m_index.insert(key, m_file.pos());
+    m_stream << key << entry;
+}
+
+bool NetworkArchive::load(const QByteArray &key, Entry *entry)
+{
+    if (m_mode != Replay)
+        return false;
+
+    QMap<QByteArray, qint64>::const_iterator it = m_index.constFind(key);
+    if (it == m_index.constEnd() || !m_file.seek(it.value()))
+        return false;
+
+    QByteArray storedKey;
+    m_stream >> storedKey >> *entry;
+    if (m_stream.status() != QDataStream::Ok || storedKey != key) {
+        m_stream.resetStatus();
+        return false;
+    }
+    return true;
+}
+
+// private:
+NetworkArchive::NetworkArchive(QObject *parent)
+    : QObject(parent)
+    , m_mode(Closed)
+{
+}
+
+bool NetworkArchive::readIndex()
+{
+    const qint64 entriesStart = m_file.pos();
+
+    if (m_file.size() >= entriesStart + qint64(ARCHIVE_TRAILER_SIZE)) {
+        qint64 indexOffset;
+        quint32 magic;
+        m_file.seek(m_file.size() - ARCHIVE_TRAILER_SIZE);
+        m_stream >> indexOffset >> magic;
+        if (m_stream.status() == QDataStream::Ok && magic == ARCHIVE_MAGIC && m_file.seek(indexOffset)) {
+            m_stream >> m_index;
+            if (m_stream.status() == QDataStream::Ok)
+                return true;
+        }
+        m_stream.resetStatus();
+    }
+
+    // The recording was not closed: rebuild the index from the entries
+    m_index.clear();
+    m_file.seek(entriesStart);
+    while (!m_stream.atEnd()) {
+        const qint64 offset = m_file.pos();
+        QByteArray key;
+        Entry entry;
+        m_stream >> key >> entry;
+        if (m_stream.status() != QDataStream::Ok)
+            break;
+        if (!m_index.contains(key))
+            m_index.insert(key, offset);
+    }
+    m_stream.resetStatus();
+    return true;
+}
+
+
+// RecordingNetworkReply
+// public:
+RecordingNetworkReply::RecordingNetworkReply(QNetworkReply *reply, NetworkArchive *archive, const QByteArray &key)
+    : QNetworkReply(reply->parent())
+    , m_reply(reply)
+    , m_archive(archive)
+    , m_key(key)
+{
+    reply->setParent(this);
+
+    setRequest(reply->request());
+    setOperation(reply->operation());
+    setUrl(reply->url());
+    open(QIODevice::ReadOnly);
+
+    connect(reply, SIGNAL(metaDataChanged()), this, SLOT(receiveMetaData()));
+    connect(reply, SIGNAL(readyRead()), this, SLOT(receiveData()));
+    connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(receiveError(QNetworkReply::NetworkError)));
+    connect(reply, SIGNAL(finished()), this, SLOT(receiveFinished()));
+    connect(reply, SIGNAL(uploadProgress(qint64, qint64)), this, SIGNAL(uploadProgress(qint64, qint64)));
+    connect(reply, SIGNAL(downloadProgress(qint64, qint64)), this, SIGNAL(downloadProgress(qint64, qint64)));
+    connect(reply, SIGNAL(sslErrors(const QList<QSslError> &)), this, SIGNAL(sslErrors(const QList<QSslError> &)));
+
+    // Synchronous requests are done already
+    if (reply->isFinished()) {
+        if (reply->error() != QNetworkReply::NoError)
+            setError(reply->error(), reply->errorString());
+        receiveFinished();
+    }
+}
+
+void RecordingNetworkReply::abort()
+{
+    if (m_reply && !isFinished())
+        m_reply->abort();
+}
+
+void RecordingNetworkReply::ignoreSslErrors()
+{
+    if (m_reply)
+        m_reply->ignoreSslErrors();
+}
+
+qint64 RecordingNetworkReply::bytesAvailable() const
+{
+    return m_buffer.size() + QNetworkReply::bytesAvailable();
+}
+
+bool RecordingNetworkReply::isSequential() const
+{
+    return true;
+}
+
+// protected:
+qint64 RecordingNetworkReply::readData(char *data, qint64 maxSize)
+{
+    if (m_buffer.isEmpty())
+        return isFinished() ? -1 : 0;
+
+    const qint64 size = qMin(maxSize, qint64(m_buffer.size()));
+    memcpy(data, m_buffer.constData(), size);
+    m_buffer.remove(0, size);
+    return size;
+}
+
+// private slots:
+void RecordingNetworkReply::receiveMetaData()
+{
+    copyMetaData();
+    emit metaDataChanged();
+}
+
+void RecordingNetworkReply::receiveData()
+{
+    const QByteArray data = m_reply->readAll();
+    if (data.isEmpty())
+        return;
+
+    m_buffer += data;
+    m_body += data;
+    emit readyRead();
+}
+
+void RecordingNetworkReply::receiveError(QNetworkReply::NetworkError code)
+{
+    setError(code, m_reply->errorString());
+    emit error(code);
+}
+
+void RecordingNetworkReply::receiveFinished()
+{
+    if (isFinished())
+        return;
+
+    copyMetaData();
+    receiveData();
+
+    // Requests that got a response, even an HTTP or FTP error, are replayed
+    // as such; those that never reached a server or proxy fail in replay as
+    // they are not in the archive
+    if (attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid()
+            || error() == QNetworkReply::NoError || error() > QNetworkReply::UnknownProxyError)
+        m_archive->record(m_key, this, m_body);
+    m_body.clear();
+
+    setFinished(true);
+    emit finished();
+}
+
+// private:
+void RecordingNetworkReply::copyMetaData()
+{
+    setUrl(m_reply->url());
+    foreach (const RawHeaderPair &pair, m_reply->rawHeaderPairs())
+        setRawHeader(pair.first, pair.second);
+
+    for (int code = QNetworkRequest::HttpStatusCodeAttribute; code <= QNetworkRequest::HttpTimingsAttribute; ++code) {
+        const QNetworkRequest::Attribute attribute = static_cast<QNetworkRequest::Attribute>(code);
+        const QVariant value = m_reply->attribute(attribute);
+        if (value.isValid() && isResponseAttribute(attribute))
+            setAttribute(attribute, value);
+    }
+}
+
+
+// ReplayedNetworkReply
+// public:
+ReplayedNetworkReply::ReplayedNetworkReply(QNetworkAccessManager::Operation op, const QNetworkRequest &request,
+                                           NetworkArchive *archive, const QByteArray &key, QObject *parent)
+    : QNetworkReply(parent)
+{
+    setRequest(request);
+    setOperation(op);
+    setUrl(request.url());
+    open(QIODevice::ReadOnly);
+
+    NetworkArchive::Entry entry;
+    if (archive->load(key, &entry)) {
+        foreach (const RawHeaderPair &pair, entry.headers)
+            setRawHeader(pair.first, pair.second);
+
+        // No status for FTP
+        if (entry.status > 0) {
+            setAttribute(QNetworkRequest::HttpStatusCodeAttribute, entry.status);
+            setAttribute(QNetworkRequest::HttpReasonPhraseAttribute, entry.reasonPhrase);
+        }
+        if (entry.status == 301 || entry.status == 302 || entry.status == 303 || entry.status == 307)
+            setAttribute(QNetworkRequest::RedirectionTargetAttribute, QUrl::fromEncoded(rawHeader("Location")));
+
+        if (entry.error != QNetworkReply::NoError)
+            setError(static_cast<QNetworkReply::NetworkError>(entry.error), entry.errorString);
+        m_buffer = entry.body;
+    } else {
+        setError(QNetworkReply::ContentNotFoundError, tr("Not in the network archive: %1").arg(url().toString()));
+    }
+
+    // Synchronous requests have to be done on return, and are read as such
+    // without any signal
+    if (request.attribute(QNetworkRequest::SynchronousRequestAttribute).toBool())
+        setFinished(true);
+    else
+        QMetaObject::invokeMethod(this, "emitSignals", Qt::QueuedConnection);
+}
+
+void ReplayedNetworkReply::abort()
+{
+    if (isFinished())
+        return;
+
+    m_buffer.clear();
+    setError(QNetworkReply::OperationCanceledError, tr("Operation canceled"));
+    setFinished(true);
+    emit error(QNetworkReply::OperationCanceledError);
+    emit finished();
+}
+
+qint64 ReplayedNetworkReply::bytesAvailable() const
+{
+    return m_buffer.size() + QNetworkReply::bytesAvailable();
+}
+
+bool ReplayedNetworkReply::isSequential() const
+{
+    return true;
+}
+
+// protected:
+qint64 ReplayedNetworkReply::readData(char *data, qint64 maxSize)
+{
+    if (m_buffer.isEmpty())
+        return isFinished() ? -1 : 0;
+
+    const qint64 size = qMin(maxSize, qint64(m_buffer.size()));
+    memcpy(data, m_buffer.constData(), size);
+    m_buffer.remove(0, size);
+    return size;
+}
+
+// private slots:
+void ReplayedNetworkReply::emitSignals()
+{
+    if (isFinished())
+        return;
+
+    emit metaDataChanged();
+
+    const qint64 size = m_buffer.size();
+    if (size > 0) {
+        emit readyRead();
+        emit downloadProgress(size, size);
+    }
+
+    const QNetworkReply::NetworkError code = error();
+    setFinished(true);
+    if (code != QNetworkReply::NoError)
+        emit error(code);
+    emit finished();
+}
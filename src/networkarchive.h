@@ -0,0 +1,154 @@
+/*
+  This file is part of the PhantomJS project from Ofi Labs.
+
+  Copyright (C) 2013 execjosh, http://execjosh.blogspot.com
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+  THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef NETWORKARCHIVE_H
+#define NETWORKARCHIVE_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QPointer>
+
+class QNetworkRequest;
+class QUrl;
+
+/**
+ * File of the responses to network requests, keyed by method, URL and body.
+ * When recording, every response is appended as it finishes and the index is
+ * written on close. When replaying, the index is read on open and responses
+ * are read from disk as they are requested.
+ */
+class NetworkArchive : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Mode {
+        Closed,
+        Record,
+        Replay
+    };
+
+    struct Entry {
+        int status;
+        QByteArray reasonPhrase;
+        int error;
+        QString errorString;
+        QList<QNetworkReply::RawHeaderPair> headers;
+        QByteArray body;
+    };
+
+    static NetworkArchive *instance();
+    virtual ~NetworkArchive();
+
+    bool open(const QString &fileName, Mode mode);
+    void close();
+    Mode mode() const;
+
+    static QByteArray key(const QByteArray &method, const QUrl &url, const QByteArray &body);
+
+    void record(const QByteArray &key, const QNetworkReply *reply, const QByteArray &body);
+    bool load(const QByteArray &key, Entry *entry);
+
+private:
+    NetworkArchive(QObject *parent = 0);
+    bool readIndex();
+
+    Mode m_mode;
+    QFile m_file;
+    QDataStream m_stream;
+    QMap<QByteArray, qint64> m_index;
+};
+
+/**
+ * Passes on a reply as it is received, and records it in the archive
+ * once it finished. The wrapped reply is owned by the wrapper.
+ */
+class RecordingNetworkReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    RecordingNetworkReply(QNetworkReply *reply, NetworkArchive *archive, const QByteArray &key);
+
+    void abort();
+    void ignoreSslErrors();
+    qint64 bytesAvailable() const;
+    bool isSequential() const;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize);
+
+private slots:
+    void receiveMetaData();
+    void receiveData();
+    void receiveError(QNetworkReply::NetworkError code);
+    void receiveFinished();
+
+private:
+    void copyMetaData();
+
+    QPointer<QNetworkReply> m_reply;
+    NetworkArchive *m_archive;
+    QByteArray m_key;
+    QByteArray m_buffer;    // Not yet read
+    QByteArray m_body;      // All of it, to be archived
+};
+
+/**
+ * Reply from the archive, without going to the network. A request that is
+ * not in the archive fails with ContentNotFoundError.
+ */
+class ReplayedNetworkReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    ReplayedNetworkReply(QNetworkAccessManager::Operation op, const QNetworkRequest &request,
+                         NetworkArchive *archive, const QByteArray &key, QObject *parent = 0);
+
+    void abort();
+    qint64 bytesAvailable() const;
+    bool isSequential() const;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize);
+
+private slots:
+    void emitSignals();
+
+private:
+    QByteArray m_buffer;
+};
+
+#endif // NETWORKARCHIVE_H
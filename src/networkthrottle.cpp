@@ -0,0 +1,380 @@
+/*
+  This file is part of the PhantomJS project from Ofi Labs.
+
+  Copyright (C) 2013 execjosh, http://execjosh.blogspot.com
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+  THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "networkthrottle.h"
+
+#include <string.h>
+
+#include <QNetworkRequest>
+
+// How often the waiting replies get their share of the bucket
+#define REFILL_INTERVAL     10
+// How much of the download rate a page can burst after a pause, in ms
+#define BUCKET_DURATION     100
+// Data lost on the way is counted in TCP segments of this size
+#define SEGMENT_SIZE        1460
+// Shortest time before a lost segment is sent again, in ms
+#define MIN_RETRANSMISSION_TIMEOUT  200
+
+// NetworkThrottle
+// public:
+NetworkThrottle::NetworkThrottle(QObject *parent)
+    : QObject(parent)
+    , m_latency(0)
+    , m_downloadRate(0)
+    , m_uploadRate(0)
+    , m_packetLoss(0)
+    , m_tokens(0)
+    , m_share(-1)
+{
+    m_clock.start();
+    m_refillTimer.setInterval(REFILL_INTERVAL);
+    connect(&m_refillTimer, SIGNAL(timeout()), this, SLOT(refill()));
+}
+
+void NetworkThrottle::setLatency(int msecs)
+{
+    m_latency = qMax(0, msecs);
+}
+
+int NetworkThrottle::latency() const
+{
+    return m_latency;
+}
+
+void NetworkThrottle::setDownloadRate(int kbps)
+{
+    m_downloadRate = qMax(0, kbps);
+    m_tokens = 0;
+    m_clock.restart();
+
+    // Without a limit the waiting replies get all their data at once
+    if (!m_downloadRate)
+        refill();
+}
+
+int NetworkThrottle::downloadRate() const
+{
+    return m_downloadRate;
+}
+
+void NetworkThrottle::setUploadRate(int kbps)
+{
+    m_uploadRate = qMax(0, kbps);
+}
+
+int NetworkThrottle::uploadRate() const
+{
+    return m_uploadRate;
+}
+
+void NetworkThrottle::setPacketLoss(int percent)
+{
+    m_packetLoss = qBound(0, percent, 100);
+}
+
+int NetworkThrottle::packetLoss() const
+{
+    return m_packetLoss;
+}
+
+bool NetworkThrottle::isActive() const
+{
+    return m_latency > 0 || m_downloadRate > 0 || m_uploadRate > 0 || m_packetLoss > 0;
+}
+
+qint64 NetworkThrottle::responseDelay(qint64 uploadSize) const
+{
+    qint64 delay = m_latency;
+    // 1 kbps is 1 bit per ms
+    if (m_uploadRate > 0)
+        delay += uploadSize * 8 / m_uploadRate;
+    return delay;
+}
+
+qint64 NetworkThrottle::retransmissionDelay(qint64 size) const
+{
+    if (m_packetLoss <= 0)
+        return 0;
+
+    // Every segment lost costs a retransmission timeout, one after the other
+    const qint64 timeout = qMax(MIN_RETRANSMISSION_TIMEOUT, 2 * m_latency);
+    qint64 delay = 0;
+    for (qint64 segments = (size + SEGMENT_SIZE - 1) / SEGMENT_SIZE; segments > 0; --segments) {
+        if (qrand() % 100 < m_packetLoss)
+            delay += timeout;
+    }
+    return delay;
+}
+
+qint64 NetworkThrottle::take(ThrottledNetworkReply *reply, qint64 wanted)
+{
+    if (m_downloadRate <= 0)
+        return wanted;
+
+    fillBucket();
+
+    qint64 granted = qMin(wanted, qint64(m_tokens));
+    if (m_share >= 0)
+        granted = qMin(granted, m_share);
+    m_tokens -= granted;
+
+    if (granted < wanted && !m_waiting.contains(reply)) {
+        m_waiting.append(reply);
+        if (!m_refillTimer.isActive())
+            m_refillTimer.start();
+    }
+    return granted;
+}
+
+// private slots:
+void NetworkThrottle::refill()
+{
+    QList<QPointer<ThrottledNetworkReply> > waiting = m_waiting;
+    m_waiting.clear();
+
+    // Split the bucket evenly, the replies that want more queue up again
+    fillBucket();
+    if (m_downloadRate > 0 && !waiting.isEmpty())
+        m_share = qMax(qint64(1), qint64(m_tokens) / waiting.count());
+
+    foreach (QPointer<ThrottledNetworkReply> reply, waiting) {
+        if (reply)
+            reply->deliver();
+    }
+    m_share = -1;
+
+    if (m_waiting.isEmpty())
+        m_refillTimer.stop();
+}
+
+// private:
+void NetworkThrottle::fillBucket()
+{
+    // kbps / 8 is bytes per ms
+    const double rate = m_downloadRate / 8.0;
+    const double capacity = qMax(1.0, rate * BUCKET_DURATION);
+    m_tokens = qMin(capacity, m_tokens + m_clock.restart() * rate);
+}
+
+
+// ThrottledNetworkReply
+// public:
+ThrottledNetworkReply::ThrottledNetworkReply(QNetworkReply *reply, NetworkThrottle *throttle, qint64 uploadSize)
+    : QNetworkReply(reply->parent())
+    , m_reply(reply)
+    , m_throttle(throttle)
+    , m_delivered(0)
+    , m_released(false)
+    , m_hasMetaData(false)
+    , m_metaDataSent(false)
+    , m_replyFinished(false)
+    , m_error(QNetworkReply::NoError)
+{
+    reply->setParent(this);
+
+    setRequest(reply->request());
+    setOperation(reply->operation());
+    setUrl(reply->url());
+    open(QIODevice::ReadOnly);
+
+    connect(reply, SIGNAL(metaDataChanged()), this, SLOT(receiveMetaData()));
+    connect(reply, SIGNAL(readyRead()), this, SLOT(receiveData()));
+    connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(receiveError(QNetworkReply::NetworkError)));
+    connect(reply, SIGNAL(finished()), this, SLOT(receiveFinished()));
+    connect(reply, SIGNAL(uploadProgress(qint64, qint64)), this, SIGNAL(uploadProgress(qint64, qint64)));
+    connect(reply, SIGNAL(sslErrors(const QList<QSslError> &)), this, SIGNAL(sslErrors(const QList<QSslError> &)));
+
+    QTimer::singleShot(throttle->responseDelay(uploadSize), this, SLOT(release()));
+}
+
+void ThrottledNetworkReply::abort()
+{
+    if (isFinished())
+        return;
+
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->abort();
+    }
+    m_pending.clear();
+    m_lost.clear();
+
+    setError(QNetworkReply::OperationCanceledError, tr("Operation canceled"));
+    setFinished(true);
+    emit error(QNetworkReply::OperationCanceledError);
+    emit finished();
+}
+
+void ThrottledNetworkReply::ignoreSslErrors()
+{
+    if (m_reply)
+        m_reply->ignoreSslErrors();
+}
+
+qint64 ThrottledNetworkReply::bytesAvailable() const
+{
+    return m_buffer.size() + QNetworkReply::bytesAvailable();
+}
+
+bool ThrottledNetworkReply::isSequential() const
+{
+    return true;
+}
+
+void ThrottledNetworkReply::deliver()
+{
+    if (!m_released || !m_lost.isEmpty() || isFinished())
+        return;
+
+    if (!m_pending.isEmpty()) {
+        const qint64 granted = m_throttle->take(this, m_pending.size());
+        if (granted > 0) {
+            sendMetaData();
+            const qint64 stall = m_throttle->retransmissionDelay(granted);
+            if (stall > 0) {
+                // Nothing after a lost segment can be read before it is resent
+                m_lost = m_pending.left(granted);
+                m_pending.remove(0, granted);
+                QTimer::singleShot(stall, this, SLOT(resend()));
+                return;
+            }
+            m_buffer.append(m_pending.constData(), granted);
+            m_pending.remove(0, granted);
+            m_delivered += granted;
+
+            emit readyRead();
+            emit downloadProgress(m_delivered, header(QNetworkRequest::ContentLengthHeader).toLongLong());
+        }
+    }
+
+    finishIfDone();
+}
+
+// protected:
+qint64 ThrottledNetworkReply::readData(char *data, qint64 maxSize)
+{
+    if (m_buffer.isEmpty())
+        return isFinished() ? -1 : 0;
+
+    const qint64 size = qMin(maxSize, qint64(m_buffer.size()));
+    memcpy(data, m_buffer.constData(), size);
+    m_buffer.remove(0, size);
+    return size;
+}
+
+// private slots:
+void ThrottledNetworkReply::release()
+{
+    m_released = true;
+    if (m_hasMetaData)
+        sendMetaData();
+    deliver();
+}
+
+void ThrottledNetworkReply::resend()
+{
+    if (m_lost.isEmpty() || isFinished())
+        return;
+
+    m_buffer.append(m_lost);
+    m_delivered += m_lost.size();
+    m_lost.clear();
+
+    emit readyRead();
+    emit downloadProgress(m_delivered, header(QNetworkRequest::ContentLengthHeader).toLongLong());
+    deliver();
+}
+
+void ThrottledNetworkReply::receiveMetaData()
+{
+    m_hasMetaData = true;
+    if (m_released)
+        sendMetaData();
+}
+
+void ThrottledNetworkReply::receiveData()
+{
+    m_hasMetaData = true;
+    m_pending.append(m_reply->readAll());
+    deliver();
+}
+
+void ThrottledNetworkReply::receiveError(QNetworkReply::NetworkError code)
+{
+    m_error = code;
+    m_errorString = m_reply->errorString();
+}
+
+void ThrottledNetworkReply::receiveFinished()
+{
+    m_hasMetaData = true;
+    m_pending.append(m_reply->readAll());
+    m_replyFinished = true;
+    deliver();
+}
+
+// private:
+void ThrottledNetworkReply::sendMetaData()
+{
+    if (m_metaDataSent || !m_reply)
+        return;
+    m_metaDataSent = true;
+
+    setUrl(m_reply->url());
+    foreach (const RawHeaderPair &pair, m_reply->rawHeaderPairs())
+        setRawHeader(pair.first, pair.second);
+
+    for (int code = QNetworkRequest::HttpStatusCodeAttribute; code <= QNetworkRequest::HttpTimingsAttribute; ++code) {
+        const QNetworkRequest::Attribute attribute = static_cast<QNetworkRequest::Attribute>(code);
+        // The zero-copy buffer would hand out the data without pacing it
+        if (attribute == QNetworkRequest::DownloadBufferAttribute)
+            continue;
+        const QVariant value = m_reply->attribute(attribute);
+        if (value.isValid())
+            setAttribute(attribute, value);
+    }
+
+    emit metaDataChanged();
+}
+
+void ThrottledNetworkReply::finishIfDone()
+{
+    if (!m_replyFinished || !m_pending.isEmpty() || !m_lost.isEmpty() || isFinished())
+        return;
+
+    sendMetaData();
+    if (m_error != QNetworkReply::NoError)
+        setError(m_error, m_errorString);
+    setFinished(true);
+
+    if (m_error != QNetworkReply::NoError)
+        emit error(m_error);
+    emit finished();
+}
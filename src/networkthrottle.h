@@ -0,0 +1,139 @@
+/*
+  This file is part of the PhantomJS project from Ofi Labs.
+
+  Copyright (C) 2013 execjosh, http://execjosh.blogspot.com
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the <organization> nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+  THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef NETWORKTHROTTLE_H
+#define NETWORKTHROTTLE_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QNetworkReply>
+#include <QPointer>
+#include <QTimer>
+
+class ThrottledNetworkReply;
+
+/**
+ * Emulates the network conditions of a page: the replies of its requests are
+ * held back for the latency and the upload time of their body, then their
+ * data is paced by a token bucket shared by all the replies of the page.
+ * Downloaded segments that are lost stall their reply until they are resent.
+ */
+class NetworkThrottle : public QObject
+{
+    Q_OBJECT
+
+public:
+    NetworkThrottle(QObject *parent = 0);
+
+    void setLatency(int msecs);
+    int latency() const;
+    void setDownloadRate(int kbps);
+    int downloadRate() const;
+    void setUploadRate(int kbps);
+    int uploadRate() const;
+    void setPacketLoss(int percent);
+    int packetLoss() const;
+
+    bool isActive() const;
+
+    // Milliseconds a request waits for its response, given the size of its body
+    qint64 responseDelay(qint64 uploadSize) const;
+    // Milliseconds until the segments of `size` bytes that got lost are resent
+    qint64 retransmissionDelay(qint64 size) const;
+
+    // Grants up to `wanted` bytes to `reply` right away, or queues it
+    // for the next refill of the bucket
+    qint64 take(ThrottledNetworkReply *reply, qint64 wanted);
+
+private slots:
+    void refill();
+
+private:
+    void fillBucket();
+
+    int m_latency;
+    int m_downloadRate;
+    int m_uploadRate;
+    int m_packetLoss;
+    double m_tokens;
+    qint64 m_share;     // Most a reply gets while the bucket is split, -1 if it is not
+    QElapsedTimer m_clock;
+    QTimer m_refillTimer;
+    QList<QPointer<ThrottledNetworkReply> > m_waiting;
+};
+
+/**
+ * Wraps the reply of a request, passing on its meta-data and data as the
+ * NetworkThrottle allows. The wrapped reply is owned by the wrapper.
+ */
+class ThrottledNetworkReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    ThrottledNetworkReply(QNetworkReply *reply, NetworkThrottle *throttle, qint64 uploadSize);
+
+    void abort();
+    void ignoreSslErrors();
+    qint64 bytesAvailable() const;
+    bool isSequential() const;
+
+    void deliver();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize);
+
+private slots:
+    void release();
+    void resend();
+    void receiveMetaData();
+    void receiveData();
+    void receiveError(QNetworkReply::NetworkError code);
+    void receiveFinished();
+
+private:
+    void sendMetaData();
+    void finishIfDone();
+
+    QPointer<QNetworkReply> m_reply;
+    NetworkThrottle *m_throttle;
+    QByteArray m_pending;   // Received, not yet let through
+    QByteArray m_lost;      // Let through, waiting to be resent
+    QByteArray m_buffer;    // Let through, not yet read
+    qint64 m_delivered;
+    bool m_released;
+    bool m_hasMetaData;
+    bool m_metaDataSent;
+    bool m_replyFinished;
+    QNetworkReply::NetworkError m_error;
+    QString m_errorString;
+};
+
+#endif // NETWORKTHROTTLE_H
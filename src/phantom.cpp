@@ -31,6 +31,7 @@
 #include "phantom.h"
 
 #include <QApplication>
+#include <QDesktopServices>
 #include <QDir>
 #include <QFileInfo>
 #include <QFile>
@@ -38,6 +39,9 @@
 #include <QDebug>
 #include <QMetaObject>
 #include <QMetaProperty>
+#include <QNetworkAccessManager>
+#include <QThread>
+#include <QWebSettings>
 
 #include "consts.h"
 #include "terminal.h"
@@ -49,6 +53,25 @@
 #include "callback.h"
 #include "cookiejar.h"
 #include "childprocess.h"
+#include "csconverter.h"
+#include "networkarchive.h"
+
+QT_BEGIN_NAMESPACE
+// Internal hooks into Qt's host name cache (see qhostinfo_p.h)
+Q_NETWORK_EXPORT void qt_qhostinfo_set_cache_limits(int maxEntries, int maxAge);
+Q_NETWORK_EXPORT bool qt_qhostinfo_save_cache(const QString &fileName);
+Q_NETWORK_EXPORT bool qt_qhostinfo_load_cache(const QString &fileName);
+#ifndef QT_NO_FREETYPE
+// Budget of the glyph cache shared by the FreeType font engines (see qfontengine_ft.cpp)
+Q_GUI_EXPORT void qt_ft_set_glyph_cache_size(int kilobytes);
+Q_GUI_EXPORT QVariantMap qt_ft_glyph_cache_statistics();
+#endif
+#ifdef Q_WS_QPA
+// Resolution of the headless platform screen (see qheadlessintegration.cpp)
+Q_GUI_EXPORT void qt_headless_set_dpi(int dpi);
+Q_GUI_EXPORT void qt_headless_set_device_pixel_ratio(qreal ratio);
+#endif
+QT_END_NAMESPACE
 
 static Phantom *phantomInstance = NULL;
 
@@ -96,9 +119,33 @@ void Phantom::init()
         return;
     }
 
+    // Trace everything from the first page on; written out on exit
+    if (!m_config.traceFile().isEmpty()) {
+        QWebSettings::startTracing();
+    }
+
     // Initialize the CookieJar
     CookieJar::instance(m_config.cookiesFile());
 
+    // Network archive, recorded by or replayed to every page from the first one on
+    if (!m_config.networkArchive().isEmpty()) {
+        const QString modeName = m_config.networkArchiveMode();
+        if (modeName != "record" && modeName != "replay") {
+            Terminal::instance()->cerr(QString("Invalid values for 'network-archive-mode' option."));
+            m_returnValue = -1;
+            m_terminated = true;
+            return;
+        }
+        // Replaying without the archive would hit the network it stands in for
+        NetworkArchive::Mode mode = modeName == "record" ? NetworkArchive::Record : NetworkArchive::Replay;
+        if (!NetworkArchive::instance()->open(m_config.networkArchive(), mode)) {
+            Terminal::instance()->cerr(QString("Unable to open network archive '%1'").arg(m_config.networkArchive()));
+            m_returnValue = -1;
+            m_terminated = true;
+            return;
+        }
+    }
+
     m_page = new WebPage(this, QUrl::fromLocalFile(m_config.scriptFile()));
     m_pages.append(m_page);
 
@@ -123,12 +170,82 @@ void Phantom::init()
         }
     }
 
+    // Decode images off the main thread, one decoding thread per core by default
+    int imageDecodingThreads = m_config.imageDecodingThreads();
+    if (imageDecodingThreads < 0) {
+        imageDecodingThreads = QThread::idealThreadCount();
+    }
+    QWebSettings::setImageDecodingThreadCount(imageDecodingThreads);
+
+    // In-memory cache of loaded resources; unset limits keep WebKit's defaults
+    QVariantMap memoryCacheSettings;
+    if (m_config.memoryCacheSize() >= 0) {
+        memoryCacheSettings["size"] = m_config.memoryCacheSize();
+    }
+    if (m_config.memoryCacheMaxDeadSize() >= 0) {
+        memoryCacheSettings["maxDeadSize"] = m_config.memoryCacheMaxDeadSize();
+    }
+    if (m_config.memoryCacheMinDeadSize() >= 0) {
+        memoryCacheSettings["minDeadSize"] = m_config.memoryCacheMinDeadSize();
+    }
+    memoryCacheSettings["pruneDecodedImagesFirst"] = m_config.memoryCachePruneDecodedImagesFirst();
+    setMemoryCache(memoryCacheSettings);
+
+    // Parse information of the scripts loaded by pages, shared across pages
+    if (m_config.scriptParseCacheSize() >= 0) {
+        QWebSettings::setScriptParseCacheCapacity(m_config.scriptParseCacheSize() * 1024);
+    }
+
+    // HTTP connections, shared by the NetworkAccessManager of every page
+    // unless told otherwise; has to happen before the first request is sent
+    QNetworkAccessManager::setHttpConnectionsPerHost(m_config.maxConnectionsPerHost());
+    QNetworkAccessManager::setHttpPipelineLength(m_config.httpPipelineDepth());
+    QNetworkAccessManager::setSharedHttpConnections(m_config.sharedConnectionsEnabled());
+
+    // DNS cache, possibly carried over from a previous run
+    qt_qhostinfo_set_cache_limits(m_config.dnsCacheSize(), m_config.dnsCacheTtl());
+    if (!m_config.dnsCacheFile().isEmpty()) {
+        qt_qhostinfo_load_cache(m_config.dnsCacheFile());
+    }
+    QWebSettings::globalSettings()->setAttribute(QWebSettings::DnsPrefetchEnabled, m_config.dnsPrefetchEnabled());
+
+    // Fonts, picked up by the platform plugin when it first populates the font database
+    if (!m_config.fontsDir().isEmpty()) {
+        qputenv("QT_QPA_FONTDIR", QFile::encodeName(QFileInfo(m_config.fontsDir()).absoluteFilePath()));
+    }
+    if (!m_config.fontSnapshotFile().isEmpty()) {
+        qputenv("QT_QPA_FONTCONFIG_SNAPSHOT", QFile::encodeName(QFileInfo(m_config.fontSnapshotFile()).absoluteFilePath()));
+    }
+#ifndef QT_NO_FREETYPE
+    qt_ft_set_glyph_cache_size(m_config.glyphCacheSize());
+#endif
+
+    // Screen resolution, used for everything sized in points and for the scale of page captures;
+    // left to the platform (and its environment variables) unless given
+#ifdef Q_WS_QPA
+    if (m_config.dpi() > 0) {
+        qt_headless_set_dpi(m_config.dpi());
+    }
+    if (m_config.devicePixelRatio() > 0) {
+        qt_headless_set_device_pixel_ratio(m_config.devicePixelRatio());
+    }
+#endif
+
     // Set output encoding
     Terminal::instance()->setEncoding(m_config.outputEncoding());
 
     // Set script file encoding
     m_scriptFileEnc.setEncoding(m_config.scriptEncoding());
 
+    // Scripts compiled from CoffeeScript, possibly carried over from a previous run
+    if (m_config.scriptCacheEnabled()) {
+        QString scriptCachePath = m_config.scriptCachePath();
+        if (scriptCachePath.isEmpty()) {
+            scriptCachePath = QDesktopServices::storageLocation(QDesktopServices::CacheLocation) + "/scripts";
+        }
+        CSConverter::instance()->setCacheDirectory(scriptCachePath);
+    }
+
     connect(m_page, SIGNAL(javaScriptConsoleMessageSent(QString)),
             SLOT(printConsoleMessage(QString)));
     connect(m_page, SIGNAL(initialized()),
@@ -298,6 +415,30 @@ bool Phantom::webdriverMode() const
     return m_config.isWebdriverMode();
 }
 
+QVariantMap Phantom::memoryCache() const
+{
+    const QVariantMap stats = QWebSettings::objectCacheStatistics();
+    QVariantMap result;
+    result["size"] = stats.value("capacity").toInt() / 1024;
+    result["maxDeadSize"] = stats.value("maxDeadCapacity").toInt() / 1024;
+    result["minDeadSize"] = stats.value("minDeadCapacity").toInt() / 1024;
+    result["pruneDecodedImagesFirst"] = QWebSettings::objectCachePrunesDecodedImagesFirst();
+    return result;
+}
+
+void Phantom::setMemoryCache(const QVariantMap &settings)
+{
+    const QVariantMap current = memoryCache();
+    const int size = qMax(0, settings.value("size", current.value("size")).toInt());
+    const int maxDeadSize = qBound(0, settings.value("maxDeadSize", current.value("maxDeadSize")).toInt(), size);
+    const int minDeadSize = qBound(0, settings.value("minDeadSize", current.value("minDeadSize")).toInt(), maxDeadSize);
+    QWebSettings::setObjectCacheCapacities(minDeadSize * 1024, maxDeadSize * 1024, size * 1024);
+
+    if (settings.contains("pruneDecodedImagesFirst")) {
+        QWebSettings::setObjectCachePrunesDecodedImagesFirst(settings.value("pruneDecodedImagesFirst").toBool());
+    }
+}
+
 // public slots:
 QObject *Phantom::createWebPage()
 {
@@ -354,6 +495,11 @@ QObject *Phantom::_createChildProcess()
     return m_childprocess;
 }
 
+QVariant Phantom::_coffee2js(const QString &source)
+{
+    return Utils::coffee2js(source);
+}
+
 QObject* Phantom::createCallback()
 {
     return new Callback(this);
@@ -456,6 +602,45 @@ void Phantom::clearCookies()
     CookieJar::instance()->clearCookies();
 }
 
+QVariantMap Phantom::memoryCacheStatistics() const
+{
+    return QWebSettings::objectCacheStatistics();
+}
+
+QVariantMap Phantom::scriptParseCacheStatistics() const
+{
+    return QWebSettings::scriptParseCacheStatistics();
+}
+
+QVariantMap Phantom::glyphCacheStatistics() const
+{
+#ifndef QT_NO_FREETYPE
+    return qt_ft_glyph_cache_statistics();
+#else
+    return QVariantMap();
+#endif
+}
+
+void Phantom::startTracing()
+{
+    QWebSettings::startTracing();
+}
+
+QString Phantom::stopTracing()
+{
+    return QWebSettings::stopTracing();
+}
+
+void Phantom::startProfiling(const QString &title)
+{
+    m_page->startProfiling(title);
+}
+
+QVariantMap Phantom::stopProfiling(const QString &title)
+{
+    return m_page->stopProfiling(title);
+}
+
 
 // private:
 void Phantom::doExit(int code)
@@ -467,6 +652,23 @@ void Phantom::doExit(int code)
 
     emit aboutToExit(code);
     m_terminated = true;
+
+    if (!m_config.dnsCacheFile().isEmpty()) {
+        qt_qhostinfo_save_cache(m_config.dnsCacheFile());
+    }
+
+    // Writes the index of a recorded archive
+    NetworkArchive::instance()->close();
+
+    if (!m_config.traceFile().isEmpty() && QWebSettings::isTracing()) {
+        QFile traceFile(m_config.traceFile());
+        if (traceFile.open(QFile::WriteOnly | QFile::Truncate)) {
+            traceFile.write(QWebSettings::stopTracing().toUtf8());
+        } else {
+            qWarning() << "Unable to write trace file" << m_config.traceFile();
+        }
+    }
+
     m_returnValue = code;
     qDeleteAll(m_pages);
     m_pages.clear();
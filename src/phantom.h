@@ -57,6 +57,7 @@ class Phantom : public QObject
     Q_PROPERTY(bool cookiesEnabled READ areCookiesEnabled WRITE setCookiesEnabled)
     Q_PROPERTY(QVariantList cookies READ cookies WRITE setCookies)
     Q_PROPERTY(bool webdriverMode READ webdriverMode)
+    Q_PROPERTY(QVariantMap memoryCache READ memoryCache WRITE setMemoryCache)
 
 private:
     // Private constructor: the Phantom class is a singleton
@@ -102,11 +103,32 @@ public:
 
     bool webdriverMode() const;
 
+    /**
+     * Capacities of the in-memory cache of loaded resources, shared by all pages:
+     * <pre>
+     * {
+     *   "size"                    : "overall size limit (number, in KB)",
+     *   "maxDeadSize"             : "limit for the resources no page uses (number, in KB)",
+     *   "minDeadSize"             : "size of the resources no page uses kept when the cache is full (number, in KB)",
+     *   "pruneDecodedImagesFirst" : "drop decoded images before evicting resources (boolean)"
+     * }
+     * </pre>
+     * Missing entries are left unchanged. A "size" of 0 disables the cache.
+     */
+    QVariantMap memoryCache() const;
+    void setMemoryCache(const QVariantMap &settings);
+
     /**
      * Create `child_process` module instance
      */
     Q_INVOKABLE QObject *_createChildProcess();
 
+    /**
+     * Compile CoffeeScript into JavaScript, through the script cache.
+     * Returns [true, javascript] or [false, error message].
+     */
+    Q_INVOKABLE QVariant _coffee2js(const QString &source);
+
 public slots:
     QObject *createWebPage();
     QObject *createWebServer();
@@ -166,6 +188,58 @@ public slots:
      */
     void clearCookies();
 
+    /**
+     * Usage of the in-memory cache, per type of resource ("images", "cssStyleSheets",
+     * "scripts" and "fonts") and overall. Sizes are in bytes.
+     * @brief memoryCacheStatistics
+     * @return QVariantMap as returned by QWebSettings::objectCacheStatistics()
+     */
+    QVariantMap memoryCacheStatistics() const;
+
+    /**
+     * Usage of the cache of parse information shared by the scripts of the same
+     * source across pages: "count", "size" and "capacity" (in bytes), "hits" and "misses".
+     * @brief scriptParseCacheStatistics
+     * @return QVariantMap as returned by QWebSettings::scriptParseCacheStatistics()
+     */
+    QVariantMap scriptParseCacheStatistics() const;
+
+    /**
+     * Usage of the cache of rendered glyphs shared by the font engines of all the
+     * pages: "count", "size" and "capacity" (in bytes), "hits" and "misses".
+     * Empty when Qt is built without FreeType.
+     * @brief glyphCacheStatistics
+     * @return QVariantMap
+     */
+    QVariantMap glyphCacheStatistics() const;
+
+    /**
+     * Starts recording trace events, discarding any recorded before.
+     * @brief startTracing
+     */
+    void startTracing();
+    /**
+     * Stops recording trace events.
+     * @brief stopTracing
+     * @return The recorded events in Chrome trace-event JSON format, to be loaded in about:tracing
+     */
+    QString stopTracing();
+
+    /**
+     * Starts profiling the JavaScript of the PhantomJS script itself.
+     * @brief startProfiling
+     * @param title Title of the profile
+     */
+    void startProfiling(const QString &title = QString());
+    /**
+     * Stops a profile started with <code>"startProfiling(title)"</code>, or
+     * the most recent one if no title is given.
+     * @brief stopProfiling
+     * @param title Title of the profile
+     * @return The call tree, as returned by WebPage::stopProfiling()
+     */
+    QVariantMap stopProfiling(const QString &title = QString());
+
     // exit() will not exit in debug mode. debugExit() will always exit.
     void exit(int code = 0);
     void debugExit(int code = 0);
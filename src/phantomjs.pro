@@ -18,6 +18,8 @@ HEADERS += csconverter.h \
     consts.h \
     utils.h \
     networkaccessmanager.h \
+    networkarchive.h \
+    networkthrottle.h \
     cookiejar.h \
     filesystem.h \
     system.h \
@@ -36,6 +38,8 @@ SOURCES += phantom.cpp \
     csconverter.cpp \
     utils.cpp \
     networkaccessmanager.cpp \
+    networkarchive.cpp \
+    networkthrottle.cpp \
     cookiejar.cpp \
     filesystem.cpp \
     system.cpp \
@@ -86,6 +90,9 @@ linux* {
       breakpad/src/common/linux/guid_creator.cc \
       breakpad/src/common/linux/memory_mapped_file.cc \
       breakpad/src/common/linux/safe_readlink.cc
+
+    # shm_open() for WebPage::renderToSharedMemory()
+    LIBS += -lrt
 }
 
 mac {
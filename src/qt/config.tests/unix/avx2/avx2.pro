@@ -0,0 +1,3 @@
+SOURCES = avx2.cpp
+CONFIG -= x11 qt
+mac:CONFIG -= app_bundle
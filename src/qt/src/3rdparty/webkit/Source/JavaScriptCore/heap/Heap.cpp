@@ -30,6 +30,7 @@
 #include "JSLock.h"
 #include "JSONObject.h"
 #include "Tracing.h"
+#include <wtf/TraceEvent.h>
 #include <algorithm>
 
 #define COLLECT_ON_EVERY_SLOW_ALLOCATION 0
@@ -392,6 +393,7 @@ void Heap::collectAllGarbage()
 void Heap::reset(SweepToggle sweepToggle)
 {
     ASSERT(globalData()->identifierTable == wtfThreadData().currentIdentifierTable());
+    TRACE_EVENT("gc", "Heap::collect");
     JAVASCRIPTCORE_GC_BEGIN();
 
     markRoots();
@@ -52,7 +52,7 @@ static double getCount()
     QueryPerformanceCounter(&counter);
     return static_cast<double>(counter.QuadPart) / frequency.QuadPart;
 #else
-    return currentTimeMS();
+    return realCurrentTime() * 1000.0;
 #endif
 }
 
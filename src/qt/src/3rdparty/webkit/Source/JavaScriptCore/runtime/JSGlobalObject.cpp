@@ -451,6 +451,7 @@ DynamicGlobalObjectScope::DynamicGlobalObjectScope(JSGlobalData& globalData, JSG
 #endif
     bool slotWasEmpty = !m_dynamicGlobalObjectSlot;
     m_dynamicGlobalObjectSlot = dynamicGlobalObject;
+    globalData.timeoutChecker.didEnterGlobalObject(dynamicGlobalObject);
 
     if (slotWasEmpty) {
         // Reset the date cache between JS invocations to force the VM
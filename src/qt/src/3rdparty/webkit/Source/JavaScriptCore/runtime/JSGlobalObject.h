@@ -221,6 +221,9 @@ namespace JSC {
         virtual ExecState* globalExec();
 
         virtual bool shouldInterruptScript() const { return true; }
+        // Called once a run of scripts that entered this global object first
+        // has returned, with the CPU time it took in milliseconds.
+        virtual void didFinishScriptRun(unsigned) { }
 
         virtual bool allowsAccessFrom(const JSGlobalObject*) const { return true; }
 
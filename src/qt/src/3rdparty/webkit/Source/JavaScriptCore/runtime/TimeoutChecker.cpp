@@ -39,6 +39,7 @@
 #include <windows.h>
 #else
 #include "CurrentTime.h"
+#include <time.h>
 #endif
 
 #if PLATFORM(BREWMP)
@@ -97,11 +98,18 @@ static inline unsigned getCPUTime()
     // There is only one thread in BREW, so this is enough.
     return GETUPTIMEMS();
 #else
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec cpuTime;
+    if (!clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime))
+        return cpuTime.tv_sec * 1000 + cpuTime.tv_nsec / 1000000;
+#endif
+
     // FIXME: We should return the time the current thread has spent executing.
 
-    // use a relative time from first call in order to avoid an overflow
-    static double firstTime = currentTime();
-    return static_cast<unsigned> ((currentTime() - firstTime) * 1000);
+    // use a relative time from first call in order to avoid an overflow.
+    // The real clock, as virtual time may stand still while a script runs.
+    static double firstTime = realCurrentTime();
+    return static_cast<unsigned> ((realCurrentTime() - firstTime) * 1000);
 #endif
 }
 
@@ -117,6 +125,22 @@ void TimeoutChecker::reset()
     m_ticksUntilNextCheck = ticksUntilFirstCheck;
     m_timeAtLastCheck = 0;
     m_timeExecuting = 0;
+    m_timeExecutingAtInterruptCheck = 0;
+    m_timeAtStart = getCPUTime();
+    m_globalObject = 0;
+}
+
+void TimeoutChecker::stop()
+{
+    ASSERT(m_startCount);
+    if (--m_startCount || !m_globalObject)
+        return;
+
+    // Unlike the interrupt checks, this also accounts for the runs too
+    // short to ever reach one
+    JSGlobalObject* globalObject = m_globalObject;
+    m_globalObject = 0;
+    globalObject->didFinishScriptRun(getCPUTime() - m_timeAtStart);
 }
 
 bool TimeoutChecker::didTimeOut(ExecState* exec)
@@ -138,18 +162,23 @@ bool TimeoutChecker::didTimeOut(ExecState* exec)
     m_timeAtLastCheck = currentTime;
     
     // Adjust the tick threshold so we get the next checkTimeout call in the
-    // interval specified in intervalBetweenChecks.
-    m_ticksUntilNextCheck = static_cast<unsigned>((static_cast<float>(intervalBetweenChecks) / timeDiff) * m_ticksUntilNextCheck);
+    // interval specified in intervalBetweenChecks, or sooner for short timeouts.
+    unsigned checkInterval = intervalBetweenChecks;
+    if (m_timeoutInterval)
+        checkInterval = min(checkInterval, max(m_timeoutInterval / 2, 1u));
+    m_ticksUntilNextCheck = static_cast<unsigned>((static_cast<float>(checkInterval) / timeDiff) * m_ticksUntilNextCheck);
     // If the new threshold is 0 reset it to the default threshold. This can happen if the timeDiff is higher than the
     // preferred script check time interval.
     if (m_ticksUntilNextCheck == 0)
         m_ticksUntilNextCheck = ticksUntilFirstCheck;
     
-    if (m_timeoutInterval && m_timeExecuting > m_timeoutInterval) {
+    if (m_timeoutInterval && m_timeExecuting - m_timeExecutingAtInterruptCheck > m_timeoutInterval) {
         if (exec->dynamicGlobalObject()->shouldInterruptScript())
             return true;
-        
-        reset();
+
+        // Ask again once another interval has gone by, keeping count of the
+        // time the whole run has taken.
+        m_timeExecutingAtInterruptCheck = m_timeExecuting;
     }
     
     return false;
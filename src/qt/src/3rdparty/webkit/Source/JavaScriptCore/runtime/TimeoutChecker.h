@@ -34,6 +34,7 @@
 namespace JSC {
 
     class ExecState;
+    class JSGlobalObject;
 
     class TimeoutChecker {
     public:
@@ -51,20 +52,32 @@ namespace JSC {
             ++m_startCount;
         }
 
-        void stop()
+        void stop();
+
+        // Remembers the global object whose code the current run entered
+        // first: it is told how long the run took once the checker stops.
+        void didEnterGlobalObject(JSGlobalObject* globalObject)
         {
-            ASSERT(m_startCount);
-            --m_startCount;
+            if (m_startCount && !m_globalObject)
+                m_globalObject = globalObject;
         }
 
         void reset();
 
         bool didTimeOut(ExecState*);
 
+        // CPU time, in milliseconds, that the current script run has spent so
+        // far, and since the global object was last asked whether to interrupt it.
+        unsigned timeExecuting() const { return m_timeExecuting; }
+        unsigned timeExecutingSinceInterruptCheck() const { return m_timeExecuting - m_timeExecutingAtInterruptCheck; }
+
     private:
         unsigned m_timeoutInterval;
         unsigned m_timeAtLastCheck;
         unsigned m_timeExecuting;
+        unsigned m_timeExecutingAtInterruptCheck;
+        unsigned m_timeAtStart;
+        JSGlobalObject* m_globalObject;
         unsigned m_startCount;
         unsigned m_ticksUntilNextCheck;
     };
@@ -156,7 +156,7 @@ static bool qpcAvailable()
     return available;
 }
 
-double currentTime()
+double realCurrentTime()
 {
     // Use a combination of ftime and QueryPerformanceCounter.
     // ftime returns the information we want, but doesn't have sufficient resolution.
@@ -224,7 +224,7 @@ static double currentSystemTime()
     return t.QuadPart * 0.0000001 - 11644473600.0;
 }
 
-double currentTime()
+double realCurrentTime()
 {
     static bool init = false;
     static double lastTime;
@@ -254,7 +254,7 @@ double currentTime()
 // better accuracy compared with Windows implementation of g_get_current_time:
 // (http://www.google.com/codesearch/p?hl=en#HHnNRjks1t0/glib-2.5.2/glib/gmain.c&q=g_get_current_time).
 // Non-Windows GTK builds could use gettimeofday() directly but for the sake of consistency lets use GTK function.
-double currentTime()
+double realCurrentTime()
 {
     GTimeVal now;
     g_get_current_time(&now);
@@ -263,7 +263,7 @@ double currentTime()
 
 #elif PLATFORM(WX)
 
-double currentTime()
+double realCurrentTime()
 {
     wxDateTime now = wxDateTime::UNow();
     return (double)now.GetTicks() + (double)(now.GetMillisecond() / 1000.0);
@@ -276,7 +276,7 @@ double currentTime()
 // occurrence of 00:00:00 local time.
 // We can combine GETUTCSECONDS and GETTIMEMS to calculate the number of milliseconds
 // since 1970/01/01 00:00:00 UTC.
-double currentTime()
+double realCurrentTime()
 {
     // diffSeconds is the number of seconds from 1970/01/01 to 1980/01/06
     const unsigned diffSeconds = 315964800;
@@ -285,7 +285,7 @@ double currentTime()
 
 #else
 
-double currentTime()
+double realCurrentTime()
 {
     struct timeval now;
     gettimeofday(&now, 0);
@@ -294,4 +294,34 @@ double currentTime()
 
 #endif
 
+static bool s_virtualTimeEnabled;
+static volatile double s_virtualTime;
+
+double currentTime()
+{
+    if (s_virtualTimeEnabled)
+        return s_virtualTime;
+    return realCurrentTime();
+}
+
+void setVirtualTimeEnabled(bool enabled)
+{
+    if (enabled == s_virtualTimeEnabled)
+        return;
+    if (enabled)
+        s_virtualTime = realCurrentTime();
+    s_virtualTimeEnabled = enabled;
+}
+
+bool virtualTimeEnabled()
+{
+    return s_virtualTimeEnabled;
+}
+
+void advanceVirtualTime(double seconds)
+{
+    if (s_virtualTimeEnabled && seconds > 0)
+        s_virtualTime = s_virtualTime + seconds;
+}
+
 } // namespace WTF
@@ -47,6 +47,18 @@ inline double currentTimeMS()
     return currentTime() * 1000.0;
 }
 
+// Virtual time. While enabled, currentTime() no longer follows the system
+// clock: it is frozen at the moment virtual time was turned on and only
+// moves forward through advanceVirtualTime(). Meant to be driven from the
+// main thread.
+void setVirtualTimeEnabled(bool);
+bool virtualTimeEnabled();
+void advanceVirtualTime(double seconds);
+
+// The system clock behind currentTime(), which keeps running while virtual
+// time is enabled. For measuring how long work actually takes.
+double realCurrentTime();
+
 inline void getLocalTime(const time_t* localTime, struct tm* localTM)
 {
 #if COMPILER(MSVC7_OR_LOWER) || COMPILER(MINGW) || OS(WINCE)
@@ -62,6 +74,10 @@ inline void getLocalTime(const time_t* localTime, struct tm* localTM)
 
 using WTF::currentTime;
 using WTF::currentTimeMS;
+using WTF::setVirtualTimeEnabled;
+using WTF::virtualTimeEnabled;
+using WTF::advanceVirtualTime;
+using WTF::realCurrentTime;
 using WTF::getLocalTime;
 
 #endif // CurrentTime_h
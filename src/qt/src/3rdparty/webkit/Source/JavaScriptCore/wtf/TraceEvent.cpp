@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2013 Ofi Labs
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "TraceEvent.h"
+
+#include "CurrentTime.h"
+#include "MainThread.h"
+#include "ThreadSpecific.h"
+#include "Threading.h"
+#include "Vector.h"
+#include "text/StringBuilder.h"
+
+#if PLATFORM(QT)
+#include <QElapsedTimer>
+#endif
+
+namespace WTF {
+
+volatile bool tracingEnabled = false;
+
+// Enough for several page loads worth of spans on the main thread
+static const unsigned traceBufferCapacity = 16384;
+
+struct TraceEventRecord {
+    // Literal names are kept as is; the strings are only set otherwise
+    const char* category;
+    const char* name;
+    String dynamicCategory;
+    String dynamicName;
+    String args;
+    int64_t start;
+    int64_t duration;
+    uint64_t asyncId;
+};
+
+class TraceBuffer {
+public:
+    TraceBuffer(unsigned threadId, const String& threadName)
+        : m_threadId(threadId)
+        , m_threadName(threadName)
+        , m_next(0)
+        , m_size(0)
+    {
+        m_events.resize(traceBufferCapacity);
+    }
+
+    // The lock is only ever contended while the trace is being collected
+    TraceEventRecord& lockNext()
+    {
+        m_mutex.lock();
+        TraceEventRecord& event = m_events[m_next];
+        m_next = (m_next + 1) % traceBufferCapacity;
+        if (m_size < traceBufferCapacity)
+            ++m_size;
+        return event;
+    }
+
+    void unlock() { m_mutex.unlock(); }
+
+    void clear()
+    {
+        MutexLocker locker(m_mutex);
+        m_next = 0;
+        m_size = 0;
+    }
+
+    void appendJSON(StringBuilder&, bool& first, int64_t origin);
+
+private:
+    Mutex m_mutex;
+    Vector<TraceEventRecord> m_events;
+    unsigned m_threadId;
+    String m_threadName;
+    unsigned m_next;
+    unsigned m_size;
+};
+
+struct ThreadTraceBuffer {
+    ThreadTraceBuffer() : buffer(0) { }
+    TraceBuffer* buffer;
+};
+
+// Buffers outlive their threads, so that what they recorded still shows up
+static ThreadSpecific<ThreadTraceBuffer>* threadTraceBuffers;
+static Mutex* traceBuffersMutex;
+static Vector<TraceBuffer*>* traceBuffers;
+static int64_t traceOrigin;
+
+#if PLATFORM(QT)
+static QElapsedTimer* traceClock;
+#endif
+
+int64_t traceTimestamp()
+{
+#if PLATFORM(QT)
+    return traceClock->nsecsElapsed() / 1000;
+#else
+    return static_cast<int64_t>(currentTime() * 1000000.0);
+#endif
+}
+
+static TraceBuffer* currentTraceBuffer()
+{
+    ThreadTraceBuffer* threadBuffer = *threadTraceBuffers;
+    if (!threadBuffer->buffer) {
+        MutexLocker locker(*traceBuffersMutex);
+        unsigned threadId = traceBuffers->size() + 1;
+        String threadName = isMainThread() ? String("Main") : "Thread " + String::number(threadId);
+        threadBuffer->buffer = new TraceBuffer(threadId, threadName);
+        traceBuffers->append(threadBuffer->buffer);
+    }
+    return threadBuffer->buffer;
+}
+
+void startTracing()
+{
+    ASSERT(isMainThread());
+    if (!threadTraceBuffers) {
+        threadTraceBuffers = new ThreadSpecific<ThreadTraceBuffer>;
+        traceBuffersMutex = new Mutex;
+        traceBuffers = new Vector<TraceBuffer*>;
+#if PLATFORM(QT)
+        traceClock = new QElapsedTimer;
+        traceClock->start();
+#endif
+    }
+
+    {
+        MutexLocker locker(*traceBuffersMutex);
+        for (size_t i = 0; i < traceBuffers->size(); ++i)
+            traceBuffers->at(i)->clear();
+    }
+    traceOrigin = traceTimestamp();
+    tracingEnabled = true;
+}
+
+void addTraceEvent(const char* category, const char* name, int64_t start, int64_t duration, const String& args)
+{
+    if (!tracingEnabled)
+        return;
+    TraceBuffer* buffer = currentTraceBuffer();
+    TraceEventRecord& event = buffer->lockNext();
+    event.category = category;
+    event.name = name;
+    event.dynamicCategory = String();
+    event.dynamicName = String();
+    event.args = args;
+    event.start = start;
+    event.duration = duration;
+    event.asyncId = 0;
+    buffer->unlock();
+}
+
+void addTraceEvent(const String& category, const String& name, int64_t start, int64_t duration, const String& args, uint64_t asyncId)
+{
+    if (!tracingEnabled)
+        return;
+    TraceBuffer* buffer = currentTraceBuffer();
+    TraceEventRecord& event = buffer->lockNext();
+    event.category = 0;
+    event.name = 0;
+    event.dynamicCategory = category;
+    event.dynamicName = name;
+    event.args = args;
+    event.start = start;
+    event.duration = duration;
+    event.asyncId = asyncId;
+    buffer->unlock();
+}
+
+static void appendJSONString(StringBuilder& builder, const String& string)
+{
+    builder.append('"');
+    for (unsigned i = 0; i < string.length(); ++i) {
+        UChar c = string[i];
+        if (c == '"' || c == '\\') {
+            builder.append('\\');
+            builder.append(c);
+        } else if (c < 0x20) {
+            static const char hexDigits[] = "0123456789abcdef";
+            builder.append("\\u00");
+            builder.append(hexDigits[c >> 4]);
+            builder.append(hexDigits[c & 0xf]);
+        } else
+            builder.append(c);
+    }
+    builder.append('"');
+}
+
+String traceJSONString(const String& string)
+{
+    StringBuilder builder;
+    appendJSONString(builder, string);
+    return builder.toString();
+}
+
+String traceArgs(const char* name, const String& value)
+{
+    StringBuilder builder;
+    builder.append('{');
+    appendJSONString(builder, name);
+    builder.append(':');
+    appendJSONString(builder, value);
+    builder.append('}');
+    return builder.toString();
+}
+
+static void appendJSONSeparator(StringBuilder& builder, bool& first)
+{
+    if (!first)
+        builder.append(",\n");
+    first = false;
+}
+
+static void appendJSONEvent(StringBuilder& builder, bool& first, const TraceEventRecord& event, char phase, int64_t timestamp, unsigned threadId)
+{
+    appendJSONSeparator(builder, first);
+    builder.append("{\"cat\":");
+    appendJSONString(builder, event.category ? String(event.category) : event.dynamicCategory);
+    builder.append(",\"name\":");
+    appendJSONString(builder, event.name ? String(event.name) : event.dynamicName);
+    builder.append(",\"ph\":\"");
+    builder.append(phase);
+    builder.append("\",\"ts\":");
+    builder.append(String::number(static_cast<long long>(timestamp)));
+    if (phase == 'X') {
+        builder.append(",\"dur\":");
+        builder.append(String::number(static_cast<long long>(event.duration)));
+    } else {
+        builder.append(",\"id\":\"0x");
+        builder.append(String::format("%llx", static_cast<unsigned long long>(event.asyncId)));
+        builder.append('"');
+    }
+    builder.append(",\"pid\":1,\"tid\":");
+    builder.append(String::number(threadId));
+    if (!event.args.isEmpty() && phase != 'e') {
+        builder.append(",\"args\":");
+        builder.append(event.args);
+    }
+    builder.append('}');
+}
+
+void TraceBuffer::appendJSON(StringBuilder& builder, bool& first, int64_t origin)
+{
+    MutexLocker locker(m_mutex);
+
+    appendJSONSeparator(builder, first);
+    builder.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+    builder.append(String::number(m_threadId));
+    builder.append(",\"args\":{\"name\":");
+    appendJSONString(builder, m_threadName);
+    builder.append("}}");
+
+    // Oldest first
+    unsigned oldest = (m_next + traceBufferCapacity - m_size) % traceBufferCapacity;
+    for (unsigned i = 0; i < m_size; ++i) {
+        const TraceEventRecord& event = m_events[(oldest + i) % traceBufferCapacity];
+        if (event.start < origin)
+            continue;
+        if (event.asyncId) {
+            appendJSONEvent(builder, first, event, 'b', event.start - origin, m_threadId);
+            appendJSONEvent(builder, first, event, 'e', event.start + event.duration - origin, m_threadId);
+        } else
+            appendJSONEvent(builder, first, event, 'X', event.start - origin, m_threadId);
+    }
+}
+
+String stopTracing()
+{
+    ASSERT(isMainThread());
+    if (!tracingEnabled)
+        return String();
+    tracingEnabled = false;
+
+    StringBuilder builder;
+    builder.append("{\"traceEvents\":[\n");
+    bool first = true;
+    {
+        MutexLocker locker(*traceBuffersMutex);
+        for (size_t i = 0; i < traceBuffers->size(); ++i)
+            traceBuffers->at(i)->appendJSON(builder, first, traceOrigin);
+    }
+    builder.append("\n]}\n");
+    return builder.toString();
+}
+
+} // namespace WTF
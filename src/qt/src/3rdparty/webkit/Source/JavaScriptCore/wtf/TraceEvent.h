@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2013 Ofi Labs
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TraceEvent_h
+#define TraceEvent_h
+
+#include <stdint.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/text/WTFString.h>
+
+namespace WTF {
+
+// Records spans of work in the Chrome trace-event format, so that where the
+// time of a page load or render went can be looked at in about:tracing.
+//
+// Every thread records into a ring buffer of its own, which drops the oldest
+// events once it is full; recording never waits on another thread and the
+// memory used stays bounded, so tracing can be left on. While tracing is off
+// a span costs a load and a branch.
+
+extern volatile bool tracingEnabled;
+
+inline bool isTracing() { return tracingEnabled; }
+
+// Starting discards whatever was recorded before. Stopping returns the
+// recorded events as trace-event JSON. Both are main thread only.
+void startTracing();
+String stopTracing();
+
+// Microseconds on the monotonic clock all trace events are timed with.
+int64_t traceTimestamp();
+
+// The category and name must outlive the trace, i.e. be string literals.
+// The arguments, if any, are the text of a JSON object.
+void addTraceEvent(const char* category, const char* name, int64_t start, int64_t duration, const String& args = String());
+
+// For names only known at run-time. A non-zero asyncId records the span as
+// asynchronous, so that it may overlap the other spans of its thread.
+void addTraceEvent(const String& category, const String& name, int64_t start, int64_t duration, const String& args, uint64_t asyncId);
+
+// Quotes a string for use in the arguments of an event.
+String traceJSONString(const String&);
+
+// Builds the arguments of an event holding a single string.
+String traceArgs(const char* name, const String& value);
+
+// Records the lifetime of the scope as a span.
+class TraceScope {
+    WTF_MAKE_NONCOPYABLE(TraceScope);
+public:
+    TraceScope(const char* category, const char* name)
+        : m_category(category)
+        , m_name(name)
+        , m_start(isTracing() ? traceTimestamp() : -1)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_start >= 0)
+            addTraceEvent(m_category, m_name, m_start, traceTimestamp() - m_start, m_args);
+    }
+
+    bool isRecording() const { return m_start >= 0; }
+    void setArgs(const String& args) { m_args = args; }
+
+private:
+    const char* m_category;
+    const char* m_name;
+    int64_t m_start;
+    String m_args;
+};
+
+} // namespace WTF
+
+using WTF::TraceScope;
+using WTF::traceArgs;
+using WTF::traceJSONString;
+
+#define TRACE_EVENT_JOIN2(a, b) a##b
+#define TRACE_EVENT_JOIN(a, b) TRACE_EVENT_JOIN2(a, b)
+#define TRACE_EVENT(category, name) WTF::TraceScope TRACE_EVENT_JOIN(traceScope, __LINE__)(category, name)
+
+#endif // TraceEvent_h
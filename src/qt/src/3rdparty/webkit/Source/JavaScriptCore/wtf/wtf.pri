@@ -29,6 +29,7 @@ SOURCES += \
     wtf/TCSystemAlloc.cpp \
     wtf/ThreadingNone.cpp \
     wtf/Threading.cpp \
+    wtf/TraceEvent.cpp \
     wtf/TypeTraits.cpp \
     wtf/WTFThreadData.cpp \
     wtf/text/AtomicString.cpp \
@@ -356,6 +356,7 @@ v8 {
         bindings/js/ScriptFunctionCall.cpp \
         bindings/js/ScriptGCEvent.cpp \
         bindings/js/ScriptObject.cpp \
+        bindings/js/ScriptParseCache.cpp \
         bindings/js/ScriptProfile.cpp \
         bindings/js/ScriptState.cpp \
         bindings/js/ScriptValue.cpp \
@@ -1328,6 +1329,7 @@ v8 {
         bindings/js/ScriptGCEvent.h \
         bindings/js/ScriptHeapSnapshot.h \
         bindings/js/ScriptObject.h \
+        bindings/js/ScriptParseCache.h \
         bindings/js/ScriptProfile.h \
         bindings/js/ScriptProfileNode.h \
         bindings/js/ScriptProfiler.h \
@@ -35,6 +35,8 @@
 #include "SecurityOrigin.h"
 #include "Settings.h"
 #include "WebCoreJSClientData.h"
+#include <profiler/ProfileGenerator.h>
+#include <profiler/Profiler.h>
 #include <wtf/Threading.h>
 #include <wtf/text/StringConcatenate.h>
 
@@ -92,6 +94,14 @@ ExecState* JSDOMWindowBase::globalExec()
 
 bool JSDOMWindowBase::supportsProfiling() const
 {
+    // A profile started on this window through the API needs the profile hooks
+    // whether or not the inspector is around.
+    const Vector<RefPtr<ProfileGenerator> >& profiles = Profiler::profiler()->currentProfiles();
+    for (size_t i = 0; i < profiles.size(); ++i) {
+        if (profiles[i]->origin() == this)
+            return true;
+    }
+
 #if !ENABLE(JAVASCRIPT_DEBUGGER) || !ENABLE(INSPECTOR)
     return false;
 #else
@@ -130,6 +140,15 @@ bool JSDOMWindowBase::shouldInterruptScript() const
     return page->chrome()->shouldInterruptJavaScript();
 }
 
+void JSDOMWindowBase::didFinishScriptRun(unsigned msecs)
+{
+    Frame* frame = impl()->frame();
+    if (!frame || !frame->page())
+        return;
+
+    frame->page()->chrome()->didFinishScriptRun(msecs);
+}
+
 void JSDOMWindowBase::willRemoveFromWindowShell()
 {
     setCurrentEvent(0);
@@ -59,6 +59,7 @@ namespace WebCore {
         virtual bool supportsProfiling() const;
         virtual bool supportsRichSourceInfo() const;
         virtual bool shouldInterruptScript() const;
+        virtual void didFinishScriptRun(unsigned msecs);
 
         bool allowsAccessFrom(JSC::ExecState*) const;
         bool allowsAccessFromNoErrorMessage(JSC::ExecState*) const;
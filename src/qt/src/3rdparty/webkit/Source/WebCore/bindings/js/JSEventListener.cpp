@@ -28,6 +28,7 @@
 #include "WorkerContext.h"
 #include <runtime/JSLock.h>
 #include <wtf/RefCountedLeakCounter.h>
+#include <wtf/TraceEvent.h>
 
 using namespace JSC;
 
@@ -68,6 +69,10 @@ void JSEventListener::handleEvent(ScriptExecutionContext* scriptExecutionContext
     if (!scriptExecutionContext || scriptExecutionContext->isJSExecutionForbidden())
         return;
 
+    TraceScope traceScope("js", "JSEventListener::handleEvent");
+    if (traceScope.isRecording())
+        traceScope.setArgs(traceArgs("type", event->type()));
+
     JSLock lock(SilenceAssertionsOnly);
 
     JSObject* jsFunction = this->jsFunction(scriptExecutionContext);
@@ -37,6 +37,7 @@
 #include "ScriptSourceCode.h"
 #include "ScriptValue.h"
 #include <runtime/JSLock.h>
+#include <wtf/TraceEvent.h>
 
 #if ENABLE(WORKERS)
 #include "JSWorkerContext.h"
@@ -76,6 +77,7 @@ ScheduledAction::ScheduledAction(ExecState* exec, JSValue function, DOMWrapperWo
 
 void ScheduledAction::execute(ScriptExecutionContext* context)
 {
+    TRACE_EVENT("js", "ScheduledAction::execute");
     if (context->isDocument())
         execute(static_cast<Document*>(context));
 #if ENABLE(WORKERS)
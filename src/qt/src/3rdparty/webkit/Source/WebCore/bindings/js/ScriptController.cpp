@@ -47,6 +47,7 @@
 #include <runtime/InitializeThreading.h>
 #include <runtime/JSLock.h>
 #include <wtf/Threading.h>
+#include <wtf/TraceEvent.h>
 
 using namespace JSC;
 using namespace std;
@@ -121,6 +122,10 @@ ScriptValue ScriptController::evaluateInWorld(const ScriptSourceCode& sourceCode
     const SourceCode& jsSourceCode = sourceCode.jsSourceCode();
     String sourceURL = ustringToString(jsSourceCode.provider()->url());
 
+    TraceScope traceScope("js", "ScriptController::evaluate");
+    if (traceScope.isRecording())
+        traceScope.setArgs(traceArgs("url", sourceURL));
+
     // evaluate code. Returns the JS return value or 0
     // if there was none, an error occurred or the type couldn't be converted.
 
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2013 Ofi Labs
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ScriptParseCache.h"
+
+#include <wtf/SHA1.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WebCore {
+
+static const unsigned defaultCapacity = 8 * 1024 * 1024;
+
+ScriptParseCache* ScriptParseCache::shared()
+{
+    DEFINE_STATIC_LOCAL(ScriptParseCache, cache, ());
+    return &cache;
+}
+
+ScriptParseCache::ScriptParseCache()
+    : m_capacity(defaultCapacity)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+static String sourceKey(const String& source)
+{
+    SHA1 sha1;
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(source.characters()), source.length() * sizeof(UChar));
+    Vector<uint8_t, 20> digest;
+    sha1.computeHash(digest);
+    return String(reinterpret_cast<const char*>(digest.data()), digest.size());
+}
+
+PassRefPtr<ScriptParseCache::Entry> ScriptParseCache::entryForSource(const String& source)
+{
+    if (!m_capacity || source.isEmpty())
+        return 0;
+
+    const String key = sourceKey(source);
+
+    m_recentlyUsed.remove(key);
+    m_recentlyUsed.add(key);
+
+    EntryMap::iterator it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        ++m_hits;
+        return it->second;
+    }
+
+    ++m_misses;
+    RefPtr<Entry> entry = Entry::create();
+    m_entries.set(key, entry);
+    prune();
+    return entry.release();
+}
+
+unsigned ScriptParseCache::size() const
+{
+    unsigned size = 0;
+    EntryMap::const_iterator end = m_entries.end();
+    for (EntryMap::const_iterator it = m_entries.begin(); it != end; ++it)
+        size += it->second->byteSize();
+    return size;
+}
+
+void ScriptParseCache::prune()
+{
+    unsigned currentSize = size();
+    while (currentSize > m_capacity && !m_recentlyUsed.isEmpty()) {
+        const String key = m_recentlyUsed.first();
+        m_recentlyUsed.remove(key);
+        RefPtr<Entry> entry = m_entries.take(key);
+        if (entry)
+            currentSize -= entry->byteSize();
+    }
+}
+
+void ScriptParseCache::setCapacity(unsigned bytes)
+{
+    m_capacity = bytes;
+    if (!m_capacity)
+        clear();
+    else
+        prune();
+}
+
+ScriptParseCache::Statistics ScriptParseCache::statistics() const
+{
+    Statistics stats;
+    stats.count = m_entries.size();
+    stats.size = size();
+    stats.capacity = m_capacity;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    return stats;
+}
+
+void ScriptParseCache::clear()
+{
+    m_entries.clear();
+    m_recentlyUsed.clear();
+}
+
+} // namespace WebCore
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2013 Ofi Labs
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ * TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ScriptParseCache_h
+#define ScriptParseCache_h
+
+#include <parser/SourceProviderCache.h>
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/RefCounted.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+// Keeps the function parse information of loaded scripts by the SHA-1 of
+// their source, so that the CachedScripts of a library used by many pages
+// share it whatever URL they came from. Only the first page to run such a
+// script parses its function bodies; the parser skips them on every other
+// page, whichever global object runs it.
+//
+// Entries are evicted least recently used first once their total size goes
+// over the capacity. A CachedScript keeps using an evicted entry until it
+// lets go of it.
+class ScriptParseCache {
+    WTF_MAKE_NONCOPYABLE(ScriptParseCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    class Entry : public RefCounted<Entry> {
+    public:
+        static PassRefPtr<Entry> create() { return adoptRef(new Entry); }
+
+        JSC::SourceProviderCache* cache() { return &m_cache; }
+        unsigned byteSize() const { return m_cache.byteSize(); }
+
+    private:
+        Entry() { }
+
+        JSC::SourceProviderCache m_cache;
+    };
+
+    struct Statistics {
+        unsigned count;
+        unsigned size;
+        unsigned capacity;
+        unsigned hits;
+        unsigned misses;
+    };
+
+    static ScriptParseCache* shared();
+
+    // Returns 0 if the cache is disabled.
+    PassRefPtr<Entry> entryForSource(const String& source);
+
+    // To be called after an entry grew.
+    void prune();
+
+    // A capacity of 0 disables the cache.
+    void setCapacity(unsigned bytes);
+    unsigned capacity() const { return m_capacity; }
+
+    Statistics statistics() const;
+    void clear();
+
+private:
+    ScriptParseCache();
+
+    unsigned size() const;
+
+    typedef HashMap<String, RefPtr<Entry> > EntryMap;
+    EntryMap m_entries;
+    // Least recently used first.
+    ListHashSet<String> m_recentlyUsed;
+    unsigned m_capacity;
+    unsigned m_hits;
+    unsigned m_misses;
+};
+
+} // namespace WebCore
+
+#endif // ScriptParseCache_h
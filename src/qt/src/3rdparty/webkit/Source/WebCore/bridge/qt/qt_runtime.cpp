@@ -43,6 +43,7 @@
 #include "RegExpObject.h"
 #include "qdatetime.h"
 #include "qdebug.h"
+#include "qhash.h"
 #include "qmetaobject.h"
 #include "qmetatype.h"
 #include "qobject.h"
@@ -55,6 +56,8 @@
 #include <runtime/Error.h>
 #include <runtime_array.h>
 #include <runtime_object.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/TraceEvent.h>
 
 // QtScript has these
 Q_DECLARE_METATYPE(QObjectList);
@@ -1160,6 +1163,120 @@ static int indexOfMetaEnum(const QMetaObject *meta, const QByteArray &str)
     return -1;
 }
 
+// Inline cache for method resolution.
+//
+// Resolving a call by name means walking every method of the meta object,
+// parsing parameter type names and converting each argument once per
+// overload candidate. For arguments that are JS primitives the outcome of
+// that search depends only on the (meta object, name, argument types)
+// triple, so it can be remembered and replayed on the next call.
+struct QtMethodCacheEntry
+{
+    int index;
+    int matchDistance;
+    QVector<QMetaType::Type> types; // return type first, then parameters
+};
+
+typedef QHash<QPair<const QMetaObject*, QByteArray>, QtMethodCacheEntry> QtMethodCache;
+
+static const int cMaxMethodCacheSize = 1024;
+
+static QtMethodCache& methodCache()
+{
+    DEFINE_STATIC_LOCAL(QtMethodCache, cache, ());
+    return cache;
+}
+
+// Builds the cache key for the current call: the signature, the private
+// access flag and one tag per argument. Returns false if any argument is
+// not a primitive, since conversions of objects depend on more than their type.
+static bool methodCacheKey(ExecState* exec, const QByteArray& signature, bool allowPrivate, QByteArray& key)
+{
+    const unsigned argc = exec->argumentCount();
+    key.reserve(signature.size() + argc + 2);
+    key = signature;
+    key += allowPrivate ? '+' : '-';
+    for (unsigned i = 0; i < argc; ++i) {
+        JSValue arg = exec->argument(i);
+        if (arg.isNumber())
+            key += 'd';
+        else if (arg.isString())
+            key += 's';
+        else if (arg.isBoolean())
+            key += 'b';
+        else if (arg.isNull())
+            key += 'n';
+        else if (arg.isUndefined())
+            key += 'u';
+        else
+            return false;
+    }
+    return true;
+}
+
+// Specialized conversions for the common primitive signatures. Anything
+// else, including NaN, goes through convertValueToQVariant().
+static QVariant convertPrimitiveArgument(ExecState* exec, JSValue value, QMetaType::Type type, int* distance)
+{
+    switch (type) {
+    case QMetaType::Double:
+        if (value.isNumber() && value != jsNaN()) {
+            *distance = 0;
+            return QVariant(value.uncheckedGetNumber());
+        }
+        break;
+    case QMetaType::Int:
+        if (value.isInt32()) {
+            *distance = 4;
+            return QVariant(value.asInt32());
+        }
+        break;
+    case QMetaType::Bool:
+        if (value.isBoolean()) {
+            *distance = 0;
+            return QVariant(value.isTrue());
+        }
+        break;
+    case QMetaType::QString:
+        if (value.isString()) {
+            UString ustring = value.toString(exec);
+            *distance = 0;
+            return QVariant(QString((const QChar*)ustring.impl()->characters(), ustring.length()));
+        }
+        break;
+    default:
+        break;
+    }
+    return convertValueToQVariant(exec, value, type, distance);
+}
+
+// Replays a cached resolution. Every argument is still converted and the
+// total distance must equal the one recorded, otherwise the caller falls
+// back to the full search.
+static bool applyCachedMethod(ExecState* exec, const QtMethodCacheEntry& entry,
+                              QVarLengthArray<QVariant, 10> &vars, void** vvars)
+{
+    const int count = entry.types.count();
+    vars.resize(count);
+    vars[0] = QVariant(entry.types.at(0), (void *)0); // the return value
+
+    int matchDistance = 0;
+    for (int i = 1; i < count; ++i) {
+        JSValue arg = static_cast<unsigned>(i - 1) < exec->argumentCount() ? exec->argument(i - 1) : jsUndefined();
+        int argdistance = -1;
+        vars[i] = convertPrimitiveArgument(exec, arg, entry.types.at(i), &argdistance);
+        if (argdistance < 0)
+            return false;
+        matchDistance += argdistance;
+    }
+    if (matchDistance != entry.matchDistance)
+        return false;
+
+    for (int i = 0; i < count; ++i)
+        vvars[i] = vars[i].data();
+    return true;
+}
+
 // Helper function for resolving methods
 // Largely based on code in QtScript for compatibility reasons
 static int findMethodIndex(ExecState* exec,
@@ -1170,6 +1287,19 @@ static int findMethodIndex(ExecState* exec,
                            void** vvars,
                            JSObject **pError)
 {
+    QByteArray cacheKey;
+    const bool cacheable = methodCacheKey(exec, signature, allowPrivate, cacheKey);
+    if (cacheable) {
+        QtMethodCache::const_iterator it = methodCache().constFind(qMakePair(meta, cacheKey));
+        if (it != methodCache().constEnd()) {
+            if (applyCachedMethod(exec, it.value(), vars, vvars)) {
+                *pError = 0;
+                return it.value().index;
+            }
+            vars.clear();
+        }
+    }
+
     QList<int> matchingIndices;
 
     bool overloads = !signature.contains('(');
@@ -1194,6 +1324,7 @@ static int findMethodIndex(ExecState* exec,
     }
 
     int chosenIndex = -1;
+    int chosenDistance = 0;
     *pError = 0;
     QVector<QtMethodMatchType> chosenTypes;
 
@@ -1303,6 +1434,7 @@ static int findMethodIndex(ExecState* exec,
                 && (matchDistance == 0)) {
                 // perfect match, use this one
                 chosenIndex = index;
+                chosenTypes = types;
                 break;
             } else {
                 QtMethodMatchData currentMatch(matchDistance, index, types, args);
@@ -1382,6 +1514,8 @@ static int findMethodIndex(ExecState* exec,
             *pError = throwError(exec, createTypeError(exec, message.toLatin1().constData()));
         } else {
             chosenIndex = bestMatch.index;
+            chosenDistance = bestMatch.matchDistance;
+            chosenTypes = bestMatch.types;
             args = bestMatch.args;
         }
     }
@@ -1394,6 +1528,20 @@ static int findMethodIndex(ExecState* exec,
             vars[i] = args[i];
             vvars[i] = vars[i].data();
         }
+
+        if (cacheable) {
+            QtMethodCacheEntry entry;
+            entry.index = chosenIndex;
+            entry.matchDistance = chosenDistance;
+            entry.types.reserve(chosenTypes.count());
+            foreach (const QtMethodMatchType& type, chosenTypes)
+                entry.types.append(type.typeId());
+
+            QtMethodCache& cache = methodCache();
+            if (cache.size() >= cMaxMethodCacheSize)
+                cache.clear();
+            cache.insert(qMakePair(meta, cacheKey), entry);
+        }
     }
 
     return chosenIndex;
@@ -1437,6 +1585,10 @@ EncodedJSValue QtRuntimeMetaMethod::call(ExecState* exec)
 {
     QtRuntimeMetaMethodData* d = static_cast<QtRuntimeMetaMethod *>(exec->callee())->d_func();
 
+    TraceScope traceScope("bridge", "QtRuntimeMetaMethod::call");
+    if (traceScope.isRecording())
+        traceScope.setArgs(traceArgs("method", String(d->m_signature.constData())));
+
     // We're limited to 10 args
     if (exec->argumentCount() > 10)
         return JSValue::encode(jsUndefined());
@@ -156,6 +156,7 @@
 #include <wtf/MainThread.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/StdLibExtras.h>
+#include <wtf/TraceEvent.h>
 #include <wtf/text/StringBuffer.h>
 
 #if ENABLE(SHARED_WORKERS)
@@ -1449,6 +1450,7 @@ bool Document::childNeedsAndNotInStyleRecalc()
 
 void Document::recalcStyle(StyleChange change)
 {
+    TRACE_EVENT("style", "Document::recalcStyle");
     // we should not enter style recalc while painting
     if (view() && view()->isPainting()) {
         ASSERT(!view()->isPainting());
@@ -376,6 +376,17 @@ DOMTimer* ScriptExecutionContext::findTimeout(int timeoutId)
     return m_timeouts.get(timeoutId);
 }
 
+bool ScriptExecutionContext::hasPendingTimeouts(double withinSeconds) const
+{
+    TimeoutMap::const_iterator end = m_timeouts.end();
+    for (TimeoutMap::const_iterator iter = m_timeouts.begin(); iter != end; ++iter) {
+        DOMTimer* timer = iter->second;
+        if (timer->isActive() && !timer->repeatInterval() && timer->nextFireInterval() <= withinSeconds)
+            return true;
+    }
+    return false;
+}
+
 #if ENABLE(BLOB)
 KURL ScriptExecutionContext::createPublicBlobURL(Blob* blob)
 {
@@ -140,6 +140,9 @@ namespace WebCore {
         void addTimeout(int timeoutId, DOMTimer*);
         void removeTimeout(int timeoutId);
         DOMTimer* findTimeout(int timeoutId);
+        // True if a single-shot timer is due to fire within the given number of
+        // seconds. Repeating timers are left out, as they never run out.
+        bool hasPendingTimeouts(double withinSeconds) const;
 
 #if ENABLE(BLOB)
         KURL createPublicBlobURL(Blob*);
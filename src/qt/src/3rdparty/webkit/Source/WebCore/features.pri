@@ -6,7 +6,6 @@ CONFIG(minimal) {
 
 CONFIG(production) {
     DEFINES += ENABLE_XSLT=0
-    DEFINES += ENABLE_WEB_TIMING=0
 }
 
 meegotouch {
@@ -40,6 +40,7 @@
 #include "InspectorInstrumentation.h"
 #include "NestingLevelIncrementer.h"
 #include "Settings.h"
+#include <wtf/TraceEvent.h>
 
 namespace WebCore {
 
@@ -244,6 +245,7 @@ bool HTMLDocumentParser::canTakeNextToken(SynchronousMode mode, PumpSession& ses
 
 void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
 {
+    TRACE_EVENT("parser", "HTMLDocumentParser::pumpTokenizer");
     ASSERT(!isStopped());
     ASSERT(!isScheduledForResume());
     // ASSERT that this object is both attached to the Document and protected.
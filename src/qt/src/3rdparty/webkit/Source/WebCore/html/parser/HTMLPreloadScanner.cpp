@@ -38,6 +38,7 @@
 #include "HTMLParserIdioms.h"
 #include "MediaList.h"
 #include "MediaQueryEvaluator.h"
+#include "ResourceHandle.h"
 
 namespace WebCore {
 
@@ -58,7 +59,8 @@ public:
 
     void processAttributes(const HTMLToken::AttributeList& attributes)
     {
-        if (m_tagName != imgTag
+        if (m_tagName != aTag
+            && m_tagName != imgTag
             && m_tagName != inputTag
             && m_tagName != linkTag
             && m_tagName != scriptTag)
@@ -75,6 +77,9 @@ public:
             if (m_tagName == scriptTag || m_tagName == imgTag) {
                 if (attributeName == srcAttr)
                     setUrlToLoad(attributeValue);
+            } else if (m_tagName == aTag) {
+                if (attributeName == hrefAttr)
+                    setUrlToLoad(attributeValue);
             } else if (m_tagName == linkTag) {
                 if (attributeName == hrefAttr)
                     setUrlToLoad(attributeValue);
@@ -125,6 +130,9 @@ public:
         if (m_urlToLoad.isEmpty())
             return;
 
+        if (document->isDNSPrefetchEnabled())
+            prefetchDNSForURL(document);
+
         CachedResourceLoader* cachedResourceLoader = document->cachedResourceLoader();
         if (m_tagName == scriptTag)
             cachedResourceLoader->preload(CachedResource::Script, m_urlToLoad, m_charset, scanningBody);
@@ -137,6 +145,19 @@ public:
     const AtomicString& tagName() const { return m_tagName; }
 
 private:
+    // Resolves the host ahead of the parser (and of the request, should the
+    // resource be fetched later on). Relative URLs point to the document's
+    // host, which has been resolved already.
+    void prefetchDNSForURL(Document* document)
+    {
+        if (!protocolIs(m_urlToLoad, "http") && !protocolIs(m_urlToLoad, "https") && !m_urlToLoad.startsWith("//"))
+            return;
+
+        KURL url = document->completeURL(m_urlToLoad);
+        if (url.host() != document->url().host())
+            ResourceHandle::prepareForURL(url);
+    }
+
     AtomicString m_tagName;
     String m_urlToLoad;
     String m_charset;
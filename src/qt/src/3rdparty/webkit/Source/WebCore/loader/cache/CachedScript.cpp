@@ -117,10 +117,17 @@ void CachedScript::destroyDecodedData()
     m_script = String();
     unsigned extraSize = 0;
 #if USE(JSC)
-    if (m_sourceProviderCache && m_clients.isEmpty())
-        m_sourceProviderCache->clear();
+    if (m_clients.isEmpty()) {
+        if (m_sourceProviderCache)
+            m_sourceProviderCache->clear();
+        // How long shared information is kept is up to the ScriptParseCache.
+        m_sharedSourceProviderCache = 0;
+    }
 
-    extraSize = m_sourceProviderCache ? m_sourceProviderCache->byteSize() : 0;
+    if (m_sharedSourceProviderCache)
+        extraSize = m_sharedSourceProviderCache->byteSize();
+    else if (m_sourceProviderCache)
+        extraSize = m_sourceProviderCache->byteSize();
 #endif
     setDecodedSize(extraSize);
     if (!MemoryCache::shouldMakeResourcePurgeableOnEviction() && isSafeToMakePurgeable())
@@ -133,16 +140,23 @@ void CachedScript::decodedDataDeletionTimerFired(Timer<CachedScript>*)
 }
 
 #if USE(JSC)
-JSC::SourceProviderCache* CachedScript::sourceProviderCache() const
+JSC::SourceProviderCache* CachedScript::sourceProviderCache()
 {   
-    if (!m_sourceProviderCache) 
-        m_sourceProviderCache = adoptPtr(new JSC::SourceProviderCache); 
+    if (!m_sharedSourceProviderCache && !m_sourceProviderCache) {
+        m_sharedSourceProviderCache = ScriptParseCache::shared()->entryForSource(script());
+        if (!m_sharedSourceProviderCache)
+            m_sourceProviderCache = adoptPtr(new JSC::SourceProviderCache);
+    }
+    if (m_sharedSourceProviderCache)
+        return m_sharedSourceProviderCache->cache();
     return m_sourceProviderCache.get(); 
 }
 
 void CachedScript::sourceProviderCacheSizeChanged(int delta)
 {
     setDecodedSize(decodedSize() + delta);
+    if (m_sharedSourceProviderCache)
+        ScriptParseCache::shared()->prune();
 }
 #endif
 
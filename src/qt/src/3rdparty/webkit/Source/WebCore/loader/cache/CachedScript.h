@@ -29,6 +29,10 @@
 #include "CachedResource.h"
 #include "Timer.h"
 
+#if USE(JSC)
+#include "ScriptParseCache.h"
+#endif
+
 #if USE(JSC)
 namespace JSC {
     class SourceProviderCache;
@@ -57,8 +61,9 @@ namespace WebCore {
 
         virtual void destroyDecodedData();
 #if USE(JSC)        
-        // Allows JSC to cache additional information about the source.
-        JSC::SourceProviderCache* sourceProviderCache() const;
+        // Allows JSC to cache additional information about the source. The
+        // information is shared with every other script of the same source.
+        JSC::SourceProviderCache* sourceProviderCache();
         void sourceProviderCacheSizeChanged(int delta);
 #endif
     private:
@@ -69,7 +74,8 @@ namespace WebCore {
         RefPtr<TextResourceDecoder> m_decoder;
         Timer<CachedScript> m_decodedDataDeletionTimer;
 #if USE(JSC)        
-        mutable OwnPtr<JSC::SourceProviderCache> m_sourceProviderCache;
+        OwnPtr<JSC::SourceProviderCache> m_sourceProviderCache;
+        RefPtr<ScriptParseCache::Entry> m_sharedSourceProviderCache;
 #endif
     };
 }
@@ -61,6 +61,7 @@ MemoryCache::MemoryCache()
     : m_disabled(false)
     , m_pruneEnabled(true)
     , m_inPruneDeadResources(false)
+    , m_pruneDecodedImagesFirst(false)
     , m_capacity(cDefaultCacheCapacity)
     , m_minDeadCapacity(0)
     , m_maxDeadCapacity(cDefaultCacheCapacity)
@@ -238,6 +239,26 @@ void MemoryCache::pruneDeadResources()
     
     bool canShrinkLRULists = true;
     m_inPruneDeadResources = true;
+
+    if (m_pruneDecodedImagesFirst) {
+        // Flush the decoded data of every dead image before evicting anything.
+        for (int i = size - 1; i >= 0; i--) {
+            CachedResource* current = m_allResources[i].m_tail;
+            while (current) {
+                CachedResource* prev = current->m_prevInAllResourcesList;
+                if (current->type() == CachedResource::ImageResource && !current->hasClients() && !current->isPreloaded() && current->isLoaded()) {
+                    current->destroyDecodedData();
+
+                    if (targetSize && m_deadSize <= targetSize) {
+                        m_inPruneDeadResources = false;
+                        return;
+                    }
+                }
+                current = prev;
+            }
+        }
+    }
+
     for (int i = size - 1; i >= 0; i--) {
         // Remove from the tail, since this is the least frequently accessed of the objects.
         CachedResource* current = m_allResources[i].m_tail;
@@ -122,6 +122,17 @@ public:
     //  - maxDeadBytes: The maximum number of bytes that dead resources should consume when the cache is not under pressure.
     //  - totalBytes: The maximum number of bytes that the cache should consume overall.
     void setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, unsigned totalBytes);
+    unsigned minDeadCapacity() const { return m_minDeadCapacity; }
+    unsigned maxDeadCapacity() const { return m_maxDeadCapacity; }
+    unsigned capacity() const { return m_capacity; }
+    unsigned liveSize() const { return m_liveSize; }
+    unsigned deadSize() const { return m_deadSize; }
+
+    // When set, the decoded data of all dead images is flushed before any dead resource is
+    // evicted, so that a page revisiting an image only has to decode it again instead of
+    // loading it again.
+    void setPruneDecodedImagesFirst(bool enabled) { m_pruneDecodedImagesFirst = enabled; }
+    bool pruneDecodedImagesFirst() const { return m_pruneDecodedImagesFirst; }
 
     // Turn the cache on and off.  Disabling the cache will remove all resources from the cache.  They may
     // still live on if they are referenced by some Web page though.
@@ -193,6 +204,7 @@ private:
     bool m_disabled;  // Whether or not the cache is enabled.
     bool m_pruneEnabled;
     bool m_inPruneDeadResources;
+    bool m_pruneDecodedImagesFirst;
 
     unsigned m_capacity;
     unsigned m_minDeadCapacity;
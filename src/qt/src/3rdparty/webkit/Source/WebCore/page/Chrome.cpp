@@ -341,6 +341,11 @@ bool Chrome::shouldInterruptJavaScript()
     return m_client->shouldInterruptJavaScript();
 }
 
+void Chrome::didFinishScriptRun(unsigned msecs)
+{
+    m_client->didFinishScriptRun(msecs);
+}
+
 #if ENABLE(REGISTER_PROTOCOL_HANDLER)
 void Chrome::registerProtocolHandler(const String& scheme, const String& baseURL, const String& url, const String& title) 
 {
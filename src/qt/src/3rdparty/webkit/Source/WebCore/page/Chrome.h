@@ -133,6 +133,7 @@ namespace WebCore {
         bool runJavaScriptPrompt(Frame*, const String& message, const String& defaultValue, String& result);
         void setStatusbarText(Frame*, const String&);
         bool shouldInterruptJavaScript();
+        void didFinishScriptRun(unsigned msecs);
 
 #if ENABLE(REGISTER_PROTOCOL_HANDLER)
         void registerProtocolHandler(const String& scheme, const String& baseURL, const String& url, const String& title);
@@ -130,6 +130,8 @@ namespace WebCore {
         virtual bool runJavaScriptPrompt(Frame*, const String& message, const String& defaultValue, String& result) = 0;
         virtual void setStatusbarText(const String&) = 0;
         virtual bool shouldInterruptJavaScript() = 0;
+        // CPU time, in milliseconds, taken by a run of the page's scripts
+        virtual void didFinishScriptRun(unsigned) { }
         virtual KeyboardUIMode keyboardUIMode() = 0;
 
         virtual void* webView() const = 0;
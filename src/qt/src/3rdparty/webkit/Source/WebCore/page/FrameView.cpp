@@ -61,6 +61,7 @@
 #include "Settings.h"
 #include "TextResourceDecoder.h"
 #include <wtf/CurrentTime.h>
+#include <wtf/TraceEvent.h>
 
 #if USE(ACCELERATED_COMPOSITING)
 #include "RenderLayerCompositor.h"
@@ -789,6 +790,8 @@ void FrameView::layout(bool allowSubtree)
     if (m_inLayout)
         return;
 
+    TRACE_EVENT("layout", "FrameView::layout");
+
     bool inSubframeLayoutWithFrameFlattening = parent() && m_frame->settings() && m_frame->settings()->frameFlatteningEnabled();
 
     if (inSubframeLayoutWithFrameFlattening) {
@@ -2345,6 +2348,8 @@ void FrameView::paintContents(GraphicsContext* p, const IntRect& rect)
     if (!frame())
         return;
 
+    TRACE_EVENT("paint", "FrameView::paintContents");
+
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willPaint(m_frame.get(), rect);
 
     Document* document = m_frame->document();
@@ -54,6 +54,19 @@ namespace WebCore {
     void setSharedTimerFireTime(double);
     void stopSharedTimer();
 
+#if PLATFORM(QT)
+    // While WTF virtual time is enabled the main thread shared timer does not
+    // wait in real time. It fires once the virtual clock reaches its fire time,
+    // or jumps the clock forward to it if fast-forwarding is enabled.
+    void setSharedTimerFastForwardEnabled(bool);
+    bool sharedTimerFastForwardEnabled();
+    // To be called after the virtual clock was changed.
+    void sharedTimerClockChanged();
+    // Moves the virtual clock forward to the given time, firing every timer
+    // that becomes due on the way at its own fire time.
+    void advanceSharedTimerClockTo(double);
+#endif
+
     // Implementation of SharedTimer for the main thread.
     class MainThreadSharedTimer : public SharedTimer {
     public:
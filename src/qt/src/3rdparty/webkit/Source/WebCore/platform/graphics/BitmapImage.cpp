@@ -108,6 +108,11 @@ void BitmapImage::destroyMetadataAndNotify(int framesCleared)
 
     int deltaBytes = framesCleared * -frameBytes(m_size);
     m_decodedSize += deltaBytes;
+#if PLATFORM(QT)
+    // invalidatePlatformData() dropped the downscaled frame as well
+    deltaBytes -= m_scaledFrameBytes;
+    m_scaledFrameBytes = 0;
+#endif
     if (framesCleared > 0) {
         deltaBytes -= m_decodedPropertiesSize;
         m_decodedPropertiesSize = 0;
@@ -202,6 +207,13 @@ bool BitmapImage::dataChanged(bool allDataReceived)
     // Feed all the data we've seen so far to the image decoder.
     m_allDataReceived = allDataReceived;
     m_source.setData(data(), allDataReceived);
+#if PLATFORM(QT)
+    // Start decoding now instead of when the image is first painted. This is
+    // not done in ImageSource::setData() because that one is also called to
+    // recreate the decoder after destroyDecodedData().
+    if (allDataReceived)
+        m_source.startAsyncDecoding();
+#endif
     
     // Clear the frame count.
     m_haveFrameCount = false;
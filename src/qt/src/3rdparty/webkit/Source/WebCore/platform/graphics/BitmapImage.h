@@ -242,6 +242,14 @@ protected:
     // Handle platform-specific data
     void initPlatformData();
     void invalidatePlatformData();
+
+#if PLATFORM(QT)
+    // Returns the frame to paint |src| into |dst| with. Still images painted
+    // well below their intrinsic size get decoded at a reduced size, in which
+    // case |src| is mapped to the returned pixmap.
+    NativeImagePtr frameForDrawing(GraphicsContext*, const QRectF& dst, QRectF& src);
+    void destroyScaledFrame();
+#endif
     
     // Checks to see if the image is a 1x1 solid color.  We optimize these images and just do a fill rect instead.
     // This check should happen regardless whether m_checkedForSolidColor is already set, as the frame may have
@@ -296,6 +304,12 @@ protected:
 
     mutable bool m_haveFrameCount;
     size_t m_frameCount;
+
+#if PLATFORM(QT)
+    NativeImagePtr m_scaledFrame; // Frame 0 decoded at 1 / 2^m_scaledFrameShift of the intrinsic size.
+    int m_scaledFrameShift;
+    unsigned m_scaledFrameBytes; // Reported to the observer, not part of m_decodedSize.
+#endif
 };
 
 }
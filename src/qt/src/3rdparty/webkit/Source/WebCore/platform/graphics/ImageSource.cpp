@@ -90,6 +90,14 @@ void ImageSource::setData(SharedBuffer* data, bool allDataReceived)
         m_decoder->setData(data, allDataReceived);
 }
 
+#if PLATFORM(QT)
+void ImageSource::startAsyncDecoding()
+{
+    if (m_decoder)
+        m_decoder->startAsyncDecoding();
+}
+#endif
+
 String ImageSource::filenameExtension() const
 {
     return m_decoder ? m_decoder->filenameExtension() : String();
@@ -149,6 +157,16 @@ NativeImagePtr ImageSource::createFrameAtIndex(size_t index)
     return buffer->asNewNativeImage();
 }
 
+#if PLATFORM(QT)
+NativeImagePtr ImageSource::createScaledFrame(const IntSize& size)
+{
+    if (!m_decoder || size.isEmpty())
+        return 0;
+
+    return m_decoder->createScaledFrame(size);
+}
+#endif
+
 float ImageSource::frameDurationAtIndex(size_t index)
 {
     if (!m_decoder)
@@ -162,6 +162,9 @@ public:
     bool initialized() const;
 
     void setData(SharedBuffer* data, bool allDataReceived);
+#if PLATFORM(QT)
+    void startAsyncDecoding();
+#endif
     String filenameExtension() const;
 
     bool isSizeAvailable();
@@ -178,6 +181,11 @@ public:
     // Callers should not call this after calling clear() with a higher index;
     // see comments on clear() above.
     NativeImagePtr createFrameAtIndex(size_t);
+#if PLATFORM(QT)
+    // Decodes the first frame at |size| instead of the intrinsic size. The
+    // frame is not cached by the decoder, the caller owns it.
+    NativeImagePtr createScaledFrame(const IntSize&);
+#endif
 
     float frameDurationAtIndex(size_t);
     bool frameHasAlphaAtIndex(size_t); // Whether or not the frame actually used any alpha.
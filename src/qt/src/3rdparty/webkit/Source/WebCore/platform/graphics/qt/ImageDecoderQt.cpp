@@ -31,12 +31,82 @@
 
 #include <QtCore/QByteArray>
 #include <QtCore/QBuffer>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWaitCondition>
 
 #include <QtGui/QImageReader>
 #include <qdebug.h>
 
 namespace WebCore {
 
+// Shared between the decoder and the task running in the thread pool. The
+// decoder may be destroyed while the task is still running, hence the
+// reference counting.
+struct ImageDecodeResult {
+    ImageDecodeResult() : finished(false) { }
+
+    QMutex mutex;
+    QWaitCondition condition;
+    bool finished;
+    QImage image;
+};
+
+class ImageDecodeTask : public QRunnable {
+public:
+    ImageDecodeTask(const QSharedPointer<ImageDecodeResult>& result, const QByteArray& data, const QByteArray& format)
+        : m_result(result)
+        , m_data(data)
+        , m_format(format)
+    {
+    }
+
+    virtual void run()
+    {
+        QBuffer buffer(&m_data);
+        buffer.open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+        QImageReader reader(&buffer, m_format);
+        // Same as the synchronous path: force JDCT_IFAST for JPEG
+        reader.setQuality(49);
+        QImage image = reader.read();
+
+        QMutexLocker locker(&m_result->mutex);
+        m_result->image = image;
+        m_result->finished = true;
+        m_result->condition.wakeAll();
+    }
+
+private:
+    QSharedPointer<ImageDecodeResult> m_result;
+    QByteArray m_data;
+    QByteArray m_format;
+};
+
+static int s_decodingThreadCount = 0;
+
+static QThreadPool* decodingThreadPool()
+{
+    static QThreadPool* pool = 0;
+    if (!pool) {
+        pool = new QThreadPool;
+        pool->setMaxThreadCount(qMax(1, s_decodingThreadCount));
+    }
+    return pool;
+}
+
+void ImageDecoderQt::setDecodingThreadCount(int count)
+{
+    s_decodingThreadCount = qMax(0, count);
+    if (s_decodingThreadCount)
+        decodingThreadPool()->setMaxThreadCount(s_decodingThreadCount);
+}
+
+int ImageDecoderQt::decodingThreadCount()
+{
+    return s_decodingThreadCount;
+}
+
 ImageDecoder* ImageDecoder::create(const SharedBuffer& data, ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption)
 {
     // We need at least 4 bytes to figure out what kind of image we're dealing with.
@@ -146,11 +216,30 @@ ImageFrame* ImageDecoderQt::frameBufferAtIndex(size_t index)
         return 0;
 
     ImageFrame& frame = m_frameBufferCache[index];
+    if (frame.status() != ImageFrame::FrameComplete && m_pendingDecode && internalTakeDecodedImage(index))
+        return &frame;
     if (frame.status() != ImageFrame::FrameComplete && m_reader)
         internalReadImage(index);
     return &frame;
 }
 
+void ImageDecoderQt::startAsyncDecoding()
+{
+    if (!s_decodingThreadCount || failed() || !m_reader || m_pendingDecode)
+        return;
+
+    // Animated images are decoded frame by frame on demand
+    if (m_format.isEmpty() || m_reader->supportsAnimation())
+        return;
+
+    // The task gets a deep copy: the SharedBuffer is not safe to use
+    // from another thread and may go away before the task is done.
+    QByteArray imageData(m_data->data(), m_data->size());
+
+    m_pendingDecode = QSharedPointer<ImageDecodeResult>(new ImageDecodeResult);
+    decodingThreadPool()->start(new ImageDecodeTask(m_pendingDecode, imageData, m_format));
+}
+
 void ImageDecoderQt::clearFrameBufferCache(size_t /*index*/)
 {
 }
@@ -212,6 +301,77 @@ bool ImageDecoderQt::internalHandleCurrentImage(size_t frameIndex)
     return true;
 }
 
+bool ImageDecoderQt::internalTakeDecodedImage(size_t frameIndex)
+{
+    if (frameIndex) {
+        m_pendingDecode.clear();
+        return false;
+    }
+
+    // Let the synchronous path deal with (and report) decoding errors
+    QImage image = takeAsyncDecodedImage();
+    if (image.isNull())
+        return false;
+
+    ImageFrame* const buffer = &m_frameBufferCache[frameIndex];
+    buffer->setOriginalFrameRect(IntRect(0, 0, image.width(), image.height()));
+    buffer->setStatus(ImageFrame::FrameComplete);
+    buffer->setDuration(0);
+    buffer->setPixmap(QPixmap::fromImage(image));
+
+    if (m_frameBufferCache.size() == 1)
+        clearPointers();
+    return true;
+}
+
+QImage ImageDecoderQt::takeAsyncDecodedImage()
+{
+    QSharedPointer<ImageDecodeResult> result = m_pendingDecode;
+    m_pendingDecode.clear();
+
+    QMutexLocker locker(&result->mutex);
+    while (!result->finished)
+        result->condition.wait(&result->mutex);
+
+    QImage image = result->image;
+    result->image = QImage();
+    return image;
+}
+
+QPixmap* ImageDecoderQt::createScaledFrame(const IntSize& size)
+{
+    if (failed() || !m_data || m_format.isEmpty())
+        return 0;
+
+    // Scaling down a frame that is already being decoded beats decoding
+    // the data a second time.
+    QImage image;
+    if (m_pendingDecode)
+        image = takeAsyncDecodedImage();
+
+    if (image.isNull()) {
+        QByteArray imageData = QByteArray::fromRawData(m_data->data(), m_data->size());
+        QBuffer buffer(&imageData);
+        buffer.open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+        QImageReader reader(&buffer, m_format);
+        if (reader.supportsAnimation())
+            return 0;
+
+        // QImageReader falls back to a smooth QImage::scaled() for handlers
+        // that cannot scale while decoding.
+        reader.setQuality(49);
+        reader.setScaledSize(size);
+        image = reader.read();
+    }
+
+    if (image.isNull())
+        return 0;
+    if (image.size() != QSize(size))
+        image = image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    return new QPixmap(QPixmap::fromImage(image));
+}
+
 // The QImageIOHandler is not able to tell us how many frames
 // we have and we need to parse every image. We do this by
 // increasing the m_frameBufferCache by one and try to parse
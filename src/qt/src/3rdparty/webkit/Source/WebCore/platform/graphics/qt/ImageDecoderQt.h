@@ -33,11 +33,13 @@
 #include <QtCore/QList>
 #include <QtCore/QHash>
 #include <QtCore/QBuffer>
+#include <QtCore/QSharedPointer>
 #include <wtf/OwnPtr.h>
 #include <wtf/PassOwnPtr.h>
 
 namespace WebCore {
 
+struct ImageDecodeResult;
 
 class ImageDecoderQt : public ImageDecoder
 {
@@ -55,6 +57,18 @@ public:
 
     virtual void clearFrameBufferCache(size_t clearBeforeFrame);
 
+    // Hands the complete image data over to the decoding thread pool, so the
+    // first frame is (usually) ready by the time it gets painted.
+    void startAsyncDecoding();
+
+    // Decodes the (single) frame scaled down to |size|, letting the image
+    // handler do it during decoding where it can (e.g. JPEG DCT scaling).
+    QPixmap* createScaledFrame(const IntSize&);
+
+    // Number of threads used for asynchronous decoding; 0 disables it.
+    static void setDecodingThreadCount(int);
+    static int decodingThreadCount();
+
 private:
     ImageDecoderQt(const ImageDecoderQt&);
     ImageDecoderQt &operator=(const ImageDecoderQt&);
@@ -63,6 +77,8 @@ private:
     void internalDecodeSize();
     void internalReadImage(size_t);
     bool internalHandleCurrentImage(size_t);
+    bool internalTakeDecodedImage(size_t);
+    QImage takeAsyncDecodedImage();
     void forceLoadEverything();
     void clearPointers();
 
@@ -70,6 +86,7 @@ private:
     QByteArray m_format;
     OwnPtr<QBuffer> m_buffer;
     OwnPtr<QImageReader> m_reader;
+    QSharedPointer<ImageDecodeResult> m_pendingDecode;
     mutable int m_repetitionCount;
 };
 
@@ -39,6 +39,7 @@
 #include "GraphicsContext.h"
 #include "ImageObserver.h"
 #include "PlatformString.h"
+#include "SharedBuffer.h"
 #include "StillImageQt.h"
 #include "qwebsettings.h"
 
@@ -46,6 +47,7 @@
 #include <QPainter>
 #include <QImage>
 #include <QImageReader>
+#include <QPaintEngine>
 #include <QTransform>
 
 #include <QDebug>
@@ -192,12 +194,90 @@ BitmapImage::BitmapImage(QPixmap* pixmap, ImageObserver* observer)
     checkForSolidColor();
 }
 
+// libjpeg scales by 1/2, 1/4 and 1/8 while decoding
+static const int cMaxScaledFrameShift = 3;
+
 void BitmapImage::initPlatformData()
 {
+    m_scaledFrame = 0;
+    m_scaledFrameShift = 0;
+    m_scaledFrameBytes = 0;
 }
 
 void BitmapImage::invalidatePlatformData()
 {
+    // The decoded size is adjusted by destroyMetadataAndNotify(), if at all
+    delete m_scaledFrame;
+    m_scaledFrame = 0;
+    m_scaledFrameShift = 0;
+}
+
+void BitmapImage::destroyScaledFrame()
+{
+    if (!m_scaledFrame)
+        return;
+
+    delete m_scaledFrame;
+    m_scaledFrame = 0;
+    m_scaledFrameShift = 0;
+
+    if (m_scaledFrameBytes && imageObserver())
+        imageObserver()->decodedSizeChanged(this, -static_cast<int>(m_scaledFrameBytes));
+    m_scaledFrameBytes = 0;
+}
+
+QPixmap* BitmapImage::frameForDrawing(GraphicsContext* ctxt, const QRectF& dst, QRectF& src)
+{
+    // Animations and vector output (i.e. PDF) always get the full frame
+    QPainter* painter = ctxt->platformContext();
+    if (!m_allDataReceived || frameCount() != 1
+        || !painter->paintEngine() || painter->paintEngine()->type() != QPaintEngine::Raster)
+        return nativeImageForCurrentFrame();
+
+    // Someone else (patterns, clipboard, ...) needed the full frame already
+    if (m_frames.size() && m_frames[0].m_frame) {
+        destroyScaledFrame();
+        return nativeImageForCurrentFrame();
+    }
+
+    const QTransform& transform = painter->combinedTransform();
+    const qreal scaleX = sqrt(transform.m11() * transform.m11() + transform.m12() * transform.m12());
+    const qreal scaleY = sqrt(transform.m21() * transform.m21() + transform.m22() * transform.m22());
+    const qreal scale = qMax(dst.width() * scaleX / src.width(), dst.height() * scaleY / src.height());
+
+    // Round up to a power of two, so the size only changes (and the image
+    // gets decoded again) when it is painted considerably larger.
+    int shift = 0;
+    while (shift < cMaxScaledFrameShift && scale * (2 << shift) <= 1)
+        ++shift;
+
+    if (!shift) {
+        destroyScaledFrame();
+        return nativeImageForCurrentFrame();
+    }
+
+    // Keep the largest size painted so far
+    if (!m_scaledFrame || shift < m_scaledFrameShift) {
+        const IntSize intrinsicSize = size();
+        const int divisor = 1 << shift;
+        QPixmap* frame = m_source.createScaledFrame(IntSize((intrinsicSize.width() + divisor - 1) / divisor,
+                                                            (intrinsicSize.height() + divisor - 1) / divisor));
+        if (!frame)
+            return nativeImageForCurrentFrame();
+
+        destroyScaledFrame();
+        m_scaledFrame = frame;
+        m_scaledFrameShift = shift;
+        m_scaledFrameBytes = frameBytes(IntSize(frame->width(), frame->height()));
+        if (imageObserver())
+            imageObserver()->decodedSizeChanged(this, m_scaledFrameBytes);
+    }
+
+    const IntSize intrinsicSize = size();
+    const qreal ratioX = qreal(m_scaledFrame->width()) / intrinsicSize.width();
+    const qreal ratioY = qreal(m_scaledFrame->height()) / intrinsicSize.height();
+    src = QRectF(src.x() * ratioX, src.y() * ratioY, src.width() * ratioX, src.height() * ratioY);
+    return m_scaledFrame;
 }
 
 // Drawing Routines
@@ -212,15 +292,15 @@ void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dst,
     if (normalizedSrc.isEmpty() || normalizedDst.isEmpty())
         return;
 
-    QPixmap* image = nativeImageForCurrentFrame();
-    if (!image)
-        return;
-
     if (mayFillWithSolidColor()) {
         fillWithSolidColor(ctxt, normalizedDst, solidColor(), styleColorSpace, op);
         return;
     }
 
+    QPixmap* image = frameForDrawing(ctxt, normalizedDst, normalizedSrc);
+    if (!image)
+        return;
+
     CompositeOperator previousOperator = ctxt->compositeOperation();
     ctxt->setCompositeOperation(!image->hasAlpha() && op == CompositeSourceOver ? CompositeCopy : op);
 
@@ -234,7 +314,13 @@ void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dst,
         }
     }
 
-    ctxt->platformContext()->drawPixmap(normalizedDst, *image, normalizedSrc);
+    // PDF output can embed still images exactly as they were downloaded
+    QPainter* painter = ctxt->platformContext();
+    QByteArray encodedData;
+    if (m_allDataReceived && frameCount() == 1 && m_data
+        && painter->paintEngine() && painter->paintEngine()->type() == QPaintEngine::Pdf)
+        encodedData = QByteArray::fromRawData(m_data->data(), m_data->size());
+    painter->drawPixmap(normalizedDst, *image, normalizedSrc, encodedData.isEmpty() ? 0 : &encodedData);
 
     ctxt->setCompositeOperation(previousOperator);
 
@@ -247,7 +333,8 @@ void BitmapImage::checkForSolidColor()
     m_isSolidColor = false;
     m_checkedForSolidColor = true;
 
-    if (frameCount() > 1)
+    // Don't decode the whole frame just to find out it is larger than 1x1
+    if (frameCount() > 1 || size() != IntSize(1, 1))
         return;
 
     QPixmap* framePixmap = frameAtIndex(0);
@@ -21,6 +21,7 @@
 
 #include <QObject>
 #include <QCache>
+#include <QHash>
 #include <QHostInfo>
 #include <QSet>
 #include <QString>
@@ -41,22 +42,29 @@ namespace WebCore {
                 return; // this actually happens
             if (currentLookups >= 10)
                 return; // do not launch more than 10 lookups at the same time
+            if (pendingHostnames.contains(hostname))
+                return; // links to the same host tend to come in bunches
 
             currentLookups++;
-            QHostInfo::lookupHost(hostname, this, SLOT(lookedUp(QHostInfo)));
+            pendingHostnames.insert(hostname);
+            lookupHostnames.insert(QHostInfo::lookupHost(hostname, this, SLOT(lookedUp(QHostInfo))), hostname);
         }
 
-        void lookedUp(const QHostInfo&)
+        void lookedUp(const QHostInfo& info)
         {
             // we do not cache the result, we throw it away.
             // we currently rely on the OS to cache the results. If it does not do that
             // then at least the ISP nameserver did it.
             // Since Qt 4.6.3, Qt also has a small DNS cache.
+            // Failed lookups may not carry the host name: go by the lookup id
             currentLookups--;
+            pendingHostnames.remove(lookupHostnames.take(info.lookupId()));
         }
 
     protected:
         int currentLookups;
+        QSet<QString> pendingHostnames;
+        QHash<int, QString> lookupHostnames;
     };
 
 
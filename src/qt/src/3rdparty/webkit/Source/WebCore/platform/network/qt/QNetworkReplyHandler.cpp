@@ -36,10 +36,12 @@
 #include <qwebframe.h>
 #include <qwebpage.h>
 
+#include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
 
 #include <QDebug>
 #include <QCoreApplication>
+#include <QtNetwork/private/qnetworktimestamp_p.h>
 
 // In Qt 4.8, the attribute for sending a request synchronously will be made public,
 // for now, use this hackish solution for setting the internal attribute.
@@ -476,6 +478,37 @@ void QNetworkReplyHandler::finish()
     m_replyWrapper = 0;
 }
 
+static int millisecondsSince(const QVariantMap& timings, const char* phase, double start)
+{
+    double time = timings.value(QLatin1String(phase), -1.0).toDouble();
+    return time < 0 ? -1 : static_cast<int>(time - start + 0.5);
+}
+
+// QtNetwork times the phases of a request on a monotonic clock, while the
+// Navigation Timing marks are relative to a requestTime read from currentTime().
+static PassRefPtr<ResourceLoadTiming> resourceLoadTimingFromReply(QNetworkReply* reply)
+{
+    QVariantMap timings = reply->attribute(QNetworkRequest::HttpTimingsAttribute).toMap();
+    double start = timings.value(QLatin1String("dnsStart"), -1.0).toDouble();
+    if (start < 0)
+        start = timings.value(QLatin1String("sendStart"), -1.0).toDouble();
+    if (start < 0)
+        return 0;
+
+    RefPtr<ResourceLoadTiming> timing = ResourceLoadTiming::create();
+    timing->requestTime = currentTime() - (qt_network_timestamp() / 1000000.0 - start) / 1000.0;
+    timing->dnsStart = millisecondsSince(timings, "dnsStart", start);
+    timing->dnsEnd = millisecondsSince(timings, "dnsEnd", start);
+    timing->connectStart = millisecondsSince(timings, "connectStart", start);
+    timing->connectEnd = millisecondsSince(timings, "connectEnd", start);
+    timing->sslStart = millisecondsSince(timings, "sslStart", start);
+    timing->sslEnd = millisecondsSince(timings, "sslEnd", start);
+    timing->sendStart = qMax(millisecondsSince(timings, "sendStart", start), 0);
+    timing->sendEnd = qMax(millisecondsSince(timings, "sendEnd", start), timing->sendStart);
+    timing->receiveHeadersEnd = qMax(millisecondsSince(timings, "responseStart", start), timing->sendEnd);
+    return timing.release();
+}
+
 void QNetworkReplyHandler::sendResponseIfNeeded()
 {
     ASSERT(m_replyWrapper && m_replyWrapper->reply() && !wasAborted());
@@ -521,6 +554,9 @@ void QNetworkReplyHandler::sendResponseIfNeeded()
         // Add remaining headers.
         foreach (const QNetworkReply::RawHeaderPair& pair, m_replyWrapper->reply()->rawHeaderPairs())
             response.setHTTPHeaderField(QString::fromLatin1(pair.first), QString::fromLatin1(pair.second));
+
+        if (RefPtr<ResourceLoadTiming> timing = resourceLoadTimingFromReply(m_replyWrapper->reply()))
+            response.setResourceLoadTiming(timing.release());
     }
 
     QUrl redirection = m_replyWrapper->reply()->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl();
@@ -29,6 +29,7 @@
 
 
 #include "config.h"
+#include "SharedTimer.h"
 
 #include <QBasicTimer>
 #include <QCoreApplication>
@@ -42,11 +43,15 @@ class SharedTimerQt : public QObject {
     Q_OBJECT
 
     friend void setSharedTimerFiredFunction(void (*f)());
+    friend void setSharedTimerFastForwardEnabled(bool);
+    friend bool sharedTimerFastForwardEnabled();
 public:
     static SharedTimerQt* inst();
 
     void start(double);
     void stop();
+    void clockChanged();
+    void advanceClockTo(double);
 
 protected:
     void timerEvent(QTimerEvent* ev);
@@ -59,11 +64,17 @@ private:
     ~SharedTimerQt();
     QBasicTimer m_timer;
     void (*m_timerFunction)();
+    double m_fireTime;
+    bool m_pending;
+    bool m_fastForward;
 };
 
 SharedTimerQt::SharedTimerQt()
     : QObject()
     , m_timerFunction(0)
+    , m_fireTime(0)
+    , m_pending(false)
+    , m_fastForward(false)
 {}
 
 SharedTimerQt::~SharedTimerQt()
@@ -94,6 +105,19 @@ SharedTimerQt* SharedTimerQt::inst()
 
 void SharedTimerQt::start(double fireTime)
 {
+    m_fireTime = fireTime;
+    m_pending = true;
+
+    if (virtualTimeEnabled()) {
+        // Nothing to wait for in real time: either the timer is due, or the
+        // clock is fast-forwarded to it as soon as the event loop is idle.
+        if (m_fastForward || fireTime <= currentTime())
+            m_timer.start(0, this);
+        else
+            m_timer.stop();
+        return;
+    }
+
     double interval = fireTime - currentTime();
     unsigned int intervalInMS;
     if (interval < 0)
@@ -108,15 +132,60 @@ void SharedTimerQt::start(double fireTime)
 
 void SharedTimerQt::stop()
 {
+    m_pending = false;
     m_timer.stop();
 }
 
+void SharedTimerQt::clockChanged()
+{
+    if (m_pending)
+        start(m_fireTime);
+}
+
+void SharedTimerQt::advanceClockTo(double time)
+{
+    // Timers scheduled with a zero interval over and over again would never
+    // let the clock move; leave them to the event loop.
+    const int maxFiringsWithoutProgress = 1000;
+    int firingsWithoutProgress = 0;
+
+    while (m_pending && m_timerFunction && m_fireTime <= time
+           && firingsWithoutProgress < maxFiringsWithoutProgress) {
+        const double now = currentTime();
+        if (m_fireTime > now) {
+            advanceVirtualTime(m_fireTime - now);
+            firingsWithoutProgress = 0;
+        } else
+            ++firingsWithoutProgress;
+
+        m_timer.stop();
+        m_pending = false;
+        (m_timerFunction)();
+    }
+
+    const double now = currentTime();
+    if (time > now)
+        advanceVirtualTime(time - now);
+    clockChanged();
+}
+
 void SharedTimerQt::timerEvent(QTimerEvent* ev)
 {
     if (!m_timerFunction || ev->timerId() != m_timer.timerId())
         return;
 
     m_timer.stop();
+
+    if (virtualTimeEnabled()) {
+        const double now = currentTime();
+        if (m_fireTime > now) {
+            if (!m_fastForward)
+                return;
+            advanceVirtualTime(m_fireTime - now);
+        }
+    }
+
+    m_pending = false;
     (m_timerFunction)();
 }
 
@@ -144,6 +213,42 @@ void stopSharedTimer()
     SharedTimerQt::inst()->stop();
 }
 
+void setSharedTimerFastForwardEnabled(bool enabled)
+{
+    if (!QCoreApplication::instance())
+        return;
+
+    SharedTimerQt* timer = SharedTimerQt::inst();
+    if (timer->m_fastForward == enabled)
+        return;
+    timer->m_fastForward = enabled;
+    timer->clockChanged();
+}
+
+bool sharedTimerFastForwardEnabled()
+{
+    if (!QCoreApplication::instance())
+        return false;
+
+    return SharedTimerQt::inst()->m_fastForward;
+}
+
+void sharedTimerClockChanged()
+{
+    if (!QCoreApplication::instance())
+        return;
+
+    SharedTimerQt::inst()->clockChanged();
+}
+
+void advanceSharedTimerClockTo(double time)
+{
+    if (!QCoreApplication::instance() || !virtualTimeEnabled())
+        return;
+
+    SharedTimerQt::inst()->advanceClockTo(time);
+}
+
 #include "SharedTimerQt.moc"
 
 }
@@ -59,6 +59,7 @@
 #include "NetworkingContext.h"
 #include "NodeList.h"
 #include "Page.h"
+#include "PageScriptDebugServer.h"
 #include "PlatformMouseEvent.h"
 #include "PlatformWheelEvent.h"
 #include "PrintContext.h"
@@ -95,6 +96,8 @@
 #if USE(JSC)
 #include "runtime_object.h"
 #include "runtime_root.h"
+#include <profiler/Profile.h>
+#include <profiler/Profiler.h>
 #endif
 #if USE(TEXTURE_MAPPER)
 #include "texmap/TextureMapper.h"
@@ -1578,6 +1581,118 @@ QWebSecurityOrigin QWebFrame::securityOrigin() const
     return QWebSecurityOrigin(priv);
 }
 
+#if USE(JSC)
+static QVariantMap profileNodeToVariantMap(const JSC::ProfileNode* node)
+{
+    QVariantList children;
+    const Vector<RefPtr<JSC::ProfileNode> >& nodes = node->children();
+    for (size_t i = 0; i < nodes.size(); ++i)
+        children.append(profileNodeToVariantMap(nodes[i].get()));
+
+    QVariantMap map;
+    map.insert(QLatin1String("functionName"), QString(ustringToString(node->functionName())));
+    map.insert(QLatin1String("url"), QString(ustringToString(node->url())));
+    map.insert(QLatin1String("lineNumber"), node->lineNumber());
+    map.insert(QLatin1String("callCount"), node->numberOfCalls());
+    map.insert(QLatin1String("selfTime"), node->actualSelfTime());
+    map.insert(QLatin1String("totalTime"), node->actualTotalTime());
+    map.insert(QLatin1String("children"), children);
+    return map;
+}
+#endif
+
+/*!
+    Starts recording a profile of the JavaScript executed in this frame,
+    under the given \a title.
+
+    Functions compiled before the profile started only start reporting their
+    calls once the event loop has run, since they have to be recompiled with
+    the profiler hooks.
+
+    \sa stopProfiling()
+*/
+void QWebFrame::startProfiling(const QString& title)
+{
+#if USE(JSC)
+    ScriptController* proxy = d->frame->script();
+    if (!proxy)
+        return;
+
+    JSC::JSLock lock(JSC::SilenceAssertionsOnly);
+    JSC::ExecState* exec = proxy->globalObject(mainThreadNormalWorld())->globalExec();
+    JSC::Profiler::profiler()->startProfiling(exec, stringToUString(title.isNull() ? QString(QLatin1String("")) : title));
+#if ENABLE(JAVASCRIPT_DEBUGGER)
+    PageScriptDebugServer::shared().recompileAllJSFunctionsSoon();
+#endif
+#else
+    Q_UNUSED(title);
+#endif
+}
+
+/*!
+    Stops the profile with the given \a title, or the most recently started
+    one if \a title is null, and returns its call tree.
+
+    The map has the keys \c title, \c totalTime and \c head. \c head is the
+    root of the call tree; each node has the keys \c functionName, \c url,
+    \c lineNumber, \c callCount, \c selfTime, \c totalTime and
+    \c children. Times are in milliseconds.
+
+    Returns an empty map if no such profile is running.
+
+    \sa startProfiling()
+*/
+QVariantMap QWebFrame::stopProfiling(const QString& title)
+{
+    QVariantMap result;
+#if USE(JSC)
+    ScriptController* proxy = d->frame->script();
+    if (!proxy)
+        return result;
+
+    JSC::JSLock lock(JSC::SilenceAssertionsOnly);
+    JSC::ExecState* exec = proxy->globalObject(mainThreadNormalWorld())->globalExec();
+    RefPtr<JSC::Profile> profile = JSC::Profiler::profiler()->stopProfiling(exec, stringToUString(title));
+    if (!profile)
+        return result;
+#if ENABLE(JAVASCRIPT_DEBUGGER)
+    // Drop the profiler hooks again.
+    PageScriptDebugServer::shared().recompileAllJSFunctionsSoon();
+#endif
+
+    result.insert(QLatin1String("title"), QString(ustringToString(profile->title())));
+    result.insert(QLatin1String("totalTime"), profile->head()->actualTotalTime());
+    result.insert(QLatin1String("head"), profileNodeToVariantMap(profile->head()));
+#else
+    Q_UNUSED(title);
+#endif
+    return result;
+}
+
+/*!
+    Returns true if this frame or one of its subframes has a style
+    recalculation or a layout pending, or a \c{setTimeout()} callback due
+    to run within \a msecs milliseconds.
+
+    Timers set with \c{setInterval()} are not taken into account, since
+    they never run out.
+*/
+bool QWebFrame::hasPendingRenderWork(int msecs) const
+{
+    const double withinSeconds = msecs / 1000.0;
+    for (WebCore::Frame* frame = d->frame; frame; frame = frame->tree()->traverseNext(d->frame)) {
+        if (FrameView* view = frame->view()) {
+            if (view->layoutPending() || view->needsLayout())
+                return true;
+        }
+        if (Document* document = frame->document()) {
+            if (document->isPendingStyleRecalc() || document->hasPendingTimeouts(withinSeconds))
+                return true;
+        }
+    }
+    return false;
+}
+
 WebCore::Frame* QWebFramePrivate::core(const QWebFrame* webFrame)
 {
     return webFrame->d->frame;
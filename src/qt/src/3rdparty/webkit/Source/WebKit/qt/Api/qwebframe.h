@@ -199,6 +199,11 @@ public:
 
     QWebSecurityOrigin securityOrigin() const;
 
+    void startProfiling(const QString &title = QString());
+    QVariantMap stopProfiling(const QString &title = QString());
+
+    bool hasPendingRenderWork(int msecs = 0) const;
+
 #ifndef QT_NO_PRINTER
     struct PrintCallback {
         /// height of header in points
@@ -4102,6 +4102,16 @@ quint64 QWebPage::bytesReceived() const
     for example through the JavaScript \c{window.close()} call.
 */
 
+/*!
+    \fn void QWebPage::javaScriptRunFinished(int msecs)
+
+    This signal is emitted whenever a script of the page has returned to
+    the event loop, with the CPU time in milliseconds that it took,
+    including the scripts of other pages it called.
+
+    \sa QWebSettings::setJavaScriptInterruptInterval()
+*/
+
 /*!
     \fn void QWebPage::printRequested(QWebFrame *frame)
 
@@ -380,6 +380,7 @@ Q_SIGNALS:
     void repaintRequested(const QRect& dirtyRect);
     void scrollRequested(int dx, int dy, const QRect& scrollViewRect);
     void windowCloseRequested();
+    void javaScriptRunFinished(int msecs);
     void printRequested(QWebFrame *frame);
     void linkClicked(const QUrl &url);
 
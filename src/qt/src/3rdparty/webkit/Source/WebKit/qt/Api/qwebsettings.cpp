@@ -33,12 +33,18 @@
 #endif
 #include "Page.h"
 #include "PageCache.h"
+#if USE(JSC)
+#include "JSDOMWindowBase.h"
+#include "ScriptParseCache.h"
+#endif
 #include "Settings.h"
 #include "KURL.h"
 #include "PlatformString.h"
 #include "IconDatabase.h"
 #include "PluginDatabase.h"
+#include "SharedTimer.h"
 #include "Image.h"
+#include "ImageDecoderQt.h"
 #include "IntSize.h"
 #include "ApplicationCacheStorage.h"
 #include "DatabaseTracker.h"
@@ -52,6 +58,9 @@
 #include <QUrl>
 #include <QFileInfo>
 #include <QStyle>
+#include <QStringList>
+#include <wtf/CurrentTime.h>
+#include <wtf/TraceEvent.h>
 
 #include "NetworkStateNotifier.h"
 
@@ -262,6 +271,10 @@ void QWebSettingsPrivate::apply()
                                       global->attributes.value(QWebSettings::XSSAuditingEnabled));
         settings->setXSSAuditorEnabled(value);
 
+        value = attributes.value(QWebSettings::DnsPrefetchEnabled,
+                                      global->attributes.value(QWebSettings::DnsPrefetchEnabled));
+        settings->setDNSPrefetchingEnabled(value);
+
 #if ENABLE(TILED_BACKING_STORE)
         value = attributes.value(QWebSettings::TiledBackingStoreEnabled,
                                       global->attributes.value(QWebSettings::TiledBackingStoreEnabled));
@@ -837,6 +850,329 @@ void QWebSettings::setObjectCacheCapacities(int cacheMinDeadCapacity, int cacheM
                                     qMax(0, totalCapacity));
 }
 
+/*!
+    Sets whether the memory cache flushes the decoded data of all the images
+    that are no longer referenced by a page before it evicts any resource
+    when it is over capacity.
+
+    Decoded images usually take up most of the cache and are cheaper to
+    recreate than resources that have to be loaded again. Disabled by default.
+*/
+void QWebSettings::setObjectCachePrunesDecodedImagesFirst(bool enabled)
+{
+    WebCore::memoryCache()->setPruneDecodedImagesFirst(enabled);
+}
+
+/*!
+    Returns whether the memory cache flushes decoded images before evicting
+    resources.
+
+    \sa setObjectCachePrunesDecodedImagesFirst()
+*/
+bool QWebSettings::objectCachePrunesDecodedImagesFirst()
+{
+    return WebCore::memoryCache()->pruneDecodedImagesFirst();
+}
+
+static QVariantMap objectCacheTypeStatistic(const WebCore::MemoryCache::TypeStatistic& stat)
+{
+    QVariantMap result;
+    result[QLatin1String("count")] = stat.count;
+    result[QLatin1String("size")] = stat.size;
+    result[QLatin1String("liveSize")] = stat.liveSize;
+    result[QLatin1String("decodedSize")] = stat.decodedSize;
+    result[QLatin1String("purgeableSize")] = stat.purgeableSize;
+    result[QLatin1String("purgedSize")] = stat.purgedSize;
+    return result;
+}
+
+/*!
+    Returns the current usage of the memory cache.
+
+    The map holds the entries \c images, \c cssStyleSheets, \c scripts,
+    \c xslStyleSheets and \c fonts, each a map of the \c count of resources
+    of that type and of their \c size, \c liveSize, \c decodedSize,
+    \c purgeableSize and \c purgedSize in bytes. The \c liveSize,
+    \c deadSize, \c minDeadCapacity, \c maxDeadCapacity and \c capacity
+    entries give the totals and the capacities of the cache in bytes.
+
+    \sa setObjectCacheCapacities()
+*/
+QVariantMap QWebSettings::objectCacheStatistics()
+{
+    WebCore::MemoryCache* cache = WebCore::memoryCache();
+    WebCore::MemoryCache::Statistics stats = cache->getStatistics();
+
+    QVariantMap result;
+    result[QLatin1String("images")] = objectCacheTypeStatistic(stats.images);
+    result[QLatin1String("cssStyleSheets")] = objectCacheTypeStatistic(stats.cssStyleSheets);
+    result[QLatin1String("scripts")] = objectCacheTypeStatistic(stats.scripts);
+#if ENABLE(XSLT)
+    result[QLatin1String("xslStyleSheets")] = objectCacheTypeStatistic(stats.xslStyleSheets);
+#endif
+    result[QLatin1String("fonts")] = objectCacheTypeStatistic(stats.fonts);
+    result[QLatin1String("liveSize")] = cache->liveSize();
+    result[QLatin1String("deadSize")] = cache->deadSize();
+    result[QLatin1String("minDeadCapacity")] = cache->minDeadCapacity();
+    result[QLatin1String("maxDeadCapacity")] = cache->maxDeadCapacity();
+    result[QLatin1String("capacity")] = cache->capacity();
+    return result;
+}
+
+/*!
+    Sets the capacity of the cache of script parse information to \a bytes.
+
+    Scripts with the same source share what the JavaScript parser learnt
+    about their functions, whatever page and URL they were loaded from, so
+    that only the first page to run a library fully parses it. A capacity
+    of 0 disables the sharing. The default is 8 MB.
+
+    \sa scriptParseCacheStatistics()
+*/
+void QWebSettings::setScriptParseCacheCapacity(int bytes)
+{
+#if USE(JSC)
+    WebCore::ScriptParseCache::shared()->setCapacity(qMax(0, bytes));
+#else
+    Q_UNUSED(bytes);
+#endif
+}
+
+/*!
+    Returns the current usage of the cache of script parse information.
+
+    The map holds the \c count of distinct script sources in the cache,
+    their \c size and the \c capacity of the cache in bytes, and how many
+    times a script was found in the cache (\c hits) or not (\c misses).
+
+    \sa setScriptParseCacheCapacity()
+*/
+QVariantMap QWebSettings::scriptParseCacheStatistics()
+{
+    QVariantMap result;
+#if USE(JSC)
+    WebCore::ScriptParseCache::Statistics stats = WebCore::ScriptParseCache::shared()->statistics();
+    result[QLatin1String("count")] = stats.count;
+    result[QLatin1String("size")] = stats.size;
+    result[QLatin1String("capacity")] = stats.capacity;
+    result[QLatin1String("hits")] = stats.hits;
+    result[QLatin1String("misses")] = stats.misses;
+#endif
+    return result;
+}
+
+/*!
+    Sets the interval, in milliseconds of CPU time, after which a running
+    script is checked for being interrupted to \a msecs.
+
+    Once a single script run has taken that long, and again every \a msecs
+    afterwards, QWebPage::shouldInterruptJavaScript() is called. A value
+    of 0 never checks. The default is 10 seconds.
+
+    \sa javaScriptRunTime()
+*/
+void QWebSettings::setJavaScriptInterruptInterval(int msecs)
+{
+#if USE(JSC)
+    WebCore::JSDOMWindowBase::commonJSGlobalData()->timeoutChecker.setTimeoutInterval(qMax(0, msecs));
+#else
+    Q_UNUSED(msecs);
+#endif
+}
+
+/*!
+    Returns the interval, in milliseconds of CPU time, after which a
+    running script is checked for being interrupted.
+
+    \sa setJavaScriptInterruptInterval()
+*/
+int QWebSettings::javaScriptInterruptInterval()
+{
+#if USE(JSC)
+    return WebCore::JSDOMWindowBase::commonJSGlobalData()->timeoutChecker.timeoutInterval();
+#else
+    return 0;
+#endif
+}
+
+/*!
+    Returns the CPU time, in milliseconds, the running script has taken so
+    far. It is meant to be called from QWebPage::shouldInterruptJavaScript().
+
+    \sa javaScriptRunTimeSinceInterruptCheck()
+*/
+int QWebSettings::javaScriptRunTime()
+{
+#if USE(JSC)
+    return WebCore::JSDOMWindowBase::commonJSGlobalData()->timeoutChecker.timeExecuting();
+#else
+    return 0;
+#endif
+}
+
+/*!
+    Returns the CPU time, in milliseconds, the running script has taken
+    since QWebPage::shouldInterruptJavaScript() was last called for it.
+
+    \sa javaScriptRunTime()
+*/
+int QWebSettings::javaScriptRunTimeSinceInterruptCheck()
+{
+#if USE(JSC)
+    return WebCore::JSDOMWindowBase::commonJSGlobalData()->timeoutChecker.timeExecutingSinceInterruptCheck();
+#else
+    return 0;
+#endif
+}
+
+/*!
+    Sets the number of threads used to decode images in the background to
+    \a count.
+
+    Once all of its data has been received, a still image is decoded in a
+    thread pool instead of on the main thread when it is first painted.
+    A \a count of 0 (the default) disables asynchronous image decoding.
+*/
+void QWebSettings::setImageDecodingThreadCount(int count)
+{
+    WebCore::ImageDecoderQt::setDecodingThreadCount(count);
+}
+
+/*!
+    Returns the number of threads used to decode images in the background.
+*/
+int QWebSettings::imageDecodingThreadCount()
+{
+    return WebCore::ImageDecoderQt::decodingThreadCount();
+}
+
+/*!
+    Enables or disables virtual time.
+
+    While virtual time is enabled, the clock seen by timers, animations and
+    \c{Date.now()} of all pages is frozen at the moment it was enabled and
+    only moves through advanceVirtualTime() or, if enabled, fast-forwarding.
+
+    \sa setVirtualTimeFastForwardEnabled()
+*/
+void QWebSettings::setVirtualTimeEnabled(bool enabled)
+{
+    WTF::setVirtualTimeEnabled(enabled);
+    WebCore::sharedTimerClockChanged();
+}
+
+/*!
+    Returns true if virtual time is enabled.
+*/
+bool QWebSettings::virtualTimeEnabled()
+{
+    return WTF::virtualTimeEnabled();
+}
+
+/*!
+    Moves the virtual clock forward by \a msecs milliseconds, firing the
+    timers that become due on the way, each at its own fire time.
+
+    Does nothing unless virtual time is enabled.
+*/
+void QWebSettings::advanceVirtualTime(qint64 msecs)
+{
+    if (!WTF::virtualTimeEnabled() || msecs <= 0)
+        return;
+    WebCore::advanceSharedTimerClockTo(WTF::currentTime() + msecs / 1000.0);
+}
+
+/*!
+    If \a enabled is true, the virtual clock jumps straight to the next
+    pending timer whenever the event loop has nothing else to do, instead
+    of waiting for advanceVirtualTime().
+*/
+void QWebSettings::setVirtualTimeFastForwardEnabled(bool enabled)
+{
+    WebCore::setSharedTimerFastForwardEnabled(enabled);
+}
+
+/*!
+    Returns true if the virtual clock is fast-forwarded while idle.
+*/
+bool QWebSettings::virtualTimeFastForwardEnabled()
+{
+    return WebCore::sharedTimerFastForwardEnabled();
+}
+
+/*!
+    Starts recording trace events, discarding any recorded before.
+
+    While tracing, the parser, style recalculation, layout, painting,
+    script execution, garbage collection and calls into QObjects from
+    script record how long they took, along with the events added with
+    addTraceEvent(). Each thread keeps its most recent events in a buffer
+    of fixed size, so tracing may be left on.
+
+    \sa stopTracing()
+*/
+void QWebSettings::startTracing()
+{
+    WTF::startTracing();
+}
+
+/*!
+    Stops recording trace events and returns them in the JSON format of
+    the Chrome trace viewer, or an empty string if tracing was not started.
+
+    \sa startTracing()
+*/
+QString QWebSettings::stopTracing()
+{
+    return WTF::stopTracing();
+}
+
+/*!
+    Returns true if trace events are being recorded.
+*/
+bool QWebSettings::isTracing()
+{
+    return WTF::isTracing();
+}
+
+/*!
+    Returns the time, in microseconds, on the clock trace events are
+    recorded with, or -1 if tracing is not started.
+*/
+qint64 QWebSettings::traceTimestamp()
+{
+    return WTF::isTracing() ? WTF::traceTimestamp() : -1;
+}
+
+/*!
+    Records a span of \a duration microseconds from \a start, taken from
+    traceTimestamp(), named \a name in \a category, with the arguments
+    \a args. A non-zero \a asyncId records the span as asynchronous,
+    for work that may overlap other spans of the thread, like a network
+    request.
+*/
+void QWebSettings::addTraceEvent(const QString &category, const QString &name, qint64 start, qint64 duration,
+                                 const QVariantMap &args, quint64 asyncId)
+{
+    if (!WTF::isTracing())
+        return;
+
+    QString json;
+    if (!args.isEmpty()) {
+        QStringList members;
+        for (QVariantMap::const_iterator it = args.constBegin(); it != args.constEnd(); ++it) {
+            const QVariant& value = it.value();
+            const bool isNumber = value.type() == QVariant::Int || value.type() == QVariant::LongLong
+                || value.type() == QVariant::UInt || value.type() == QVariant::ULongLong
+                || value.type() == QVariant::Double;
+            members.append(QString(WTF::traceJSONString(it.key())) + QLatin1Char(':')
+                           + (isNumber ? value.toString() : QString(WTF::traceJSONString(value.toString()))));
+        }
+        json = QLatin1Char('{') + members.join(QLatin1String(",")) + QLatin1Char('}');
+    }
+    WTF::addTraceEvent(category, name, start, duration, json, asyncId);
+}
+
 /*!
     Sets the actual font family to \a family for the specified generic family,
     \a which.
@@ -23,6 +23,7 @@
 #include "qwebkitglobal.h"
 
 #include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
 #include <QtGui/qpixmap.h>
 #include <QtGui/qicon.h>
 #include <QtCore/qshareddata.h>
@@ -130,6 +131,33 @@ public:
     static void setMaximumPagesInCache(int pages);
     static int maximumPagesInCache();
     static void setObjectCacheCapacities(int cacheMinDeadCapacity, int cacheMaxDead, int totalCapacity);
+    static void setObjectCachePrunesDecodedImagesFirst(bool enabled);
+    static bool objectCachePrunesDecodedImagesFirst();
+    static QVariantMap objectCacheStatistics();
+
+    static void setScriptParseCacheCapacity(int bytes);
+    static QVariantMap scriptParseCacheStatistics();
+
+    static void setJavaScriptInterruptInterval(int msecs);
+    static int javaScriptInterruptInterval();
+    static int javaScriptRunTime();
+    static int javaScriptRunTimeSinceInterruptCheck();
+
+    static void setImageDecodingThreadCount(int count);
+    static int imageDecodingThreadCount();
+
+    static void setVirtualTimeEnabled(bool enabled);
+    static bool virtualTimeEnabled();
+    static void advanceVirtualTime(qint64 msecs);
+    static void setVirtualTimeFastForwardEnabled(bool enabled);
+    static bool virtualTimeFastForwardEnabled();
+
+    static void startTracing();
+    static QString stopTracing();
+    static bool isTracing();
+    static qint64 traceTimestamp();
+    static void addTraceEvent(const QString &category, const QString &name, qint64 start, qint64 duration,
+                              const QVariantMap &args = QVariantMap(), quint64 asyncId = 0);
 
     static void setOfflineStoragePath(const QString& path);
     static QString offlineStoragePath();
@@ -375,6 +375,11 @@ bool ChromeClientQt::shouldInterruptJavaScript()
     return shouldInterrupt;
 }
 
+void ChromeClientQt::didFinishScriptRun(unsigned msecs)
+{
+    emit m_webPage->javaScriptRunFinished(msecs);
+}
+
 KeyboardUIMode ChromeClientQt::keyboardUIMode()
 {
     return m_webPage->settings()->testAttribute(QWebSettings::LinksIncludedInFocusChain)
@@ -108,6 +108,7 @@ public:
     virtual bool runJavaScriptConfirm(Frame*, const String&);
     virtual bool runJavaScriptPrompt(Frame*, const String& message, const String& defaultValue, String& result);
     virtual bool shouldInterruptJavaScript();
+    virtual void didFinishScriptRun(unsigned msecs);
 
     virtual void setStatusbarText(const String&);
 
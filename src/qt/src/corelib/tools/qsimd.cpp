@@ -318,6 +318,32 @@ static inline uint detectProcessorFeatures()
     if (feature_result & (1u << 28))
         features |= AVX;
 
+#if defined(Q_CC_GNU)
+    // AVX2 also needs the OS to save the YMM registers (OSXSAVE, then XCR0 bits 1 and 2)
+    if ((features & AVX) && (feature_result & (1u << 27))) {
+        uint xcr0 = 0;
+        uint xcr0_high = 0;
+        asm (".byte 0x0f, 0x01, 0xd0\n" // xgetbv
+            : "=a" (xcr0), "=d" (xcr0_high)
+            : "c" (0)
+            );
+        if ((xcr0 & 6) == 6) {
+            uint leaf = 7;
+            uint subleaf = 0;
+            quint64 extended_features;
+            asm ("xchg %%rbx, %2\n"
+                 "cpuid\n"
+                 "xchg %%rbx, %2\n"
+                : "+a" (leaf), "+c" (subleaf), "=&r" (extended_features)
+                :
+                : "%edx"
+                );
+            if (extended_features & (1u << 5))
+                features |= AVX2;
+        }
+    }
+#endif
+
     return features;
 }
 
@@ -351,6 +377,7 @@ static inline uint detectProcessorFeatures()
  sse4.1
  sse4.2
  avx
+ avx2
   */
 
 // begin generated
@@ -369,11 +396,12 @@ static const char features_string[] =
     " sse4.1\0"
     " sse4.2\0"
     " avx\0"
+    " avx2\0"
     "\0";
 
 static const int features_indices[] = {
        0,    5,   13,   23,   36,   41,   47,   53,
-      61,   67,   73,   80,   88,   96,   -1
+      61,   67,   73,   80,   88,   96,  101,   -1
 };
 // end generated
 
@@ -58,6 +58,7 @@ QT_BEGIN_HEADER
 #undef QT_HAVE_SSE4_1
 #undef QT_HAVE_SSE4_2
 #undef QT_HAVE_AVX
+#undef QT_HAVE_AVX2
 #undef QT_HAVE_3DNOW
 #undef QT_HAVE_MMX
 #endif
@@ -168,6 +169,11 @@ QT_BEGIN_HEADER
 #include <immintrin.h>
 #endif
 
+// AVX2 intrinsics
+#if defined(QT_HAVE_AVX2) && (defined(__AVX2__) || defined(Q_CC_MSVC))
+#include <immintrin.h>
+#endif
+
 
 #if !defined(QT_BOOTSTRAPPED) && (!defined(Q_CC_MSVC) || (defined(_M_X64) || _M_IX86_FP == 2))
 #define QT_ALWAYS_HAVE_SSE2
@@ -222,7 +228,8 @@ enum CPUFeatures {
     SSSE3       = 0x400,
     SSE4_1      = 0x800,
     SSE4_2      = 0x1000,
-    AVX         = 0x2000
+    AVX         = 0x2000,
+    AVX2        = 0x4000
 };
 
 Q_CORE_EXPORT uint qDetectCPUFeatures();
@@ -197,6 +197,24 @@ contains(QMAKE_MAC_XARCH, no) {
             silent:ssse3_compiler.commands = @echo compiling[ssse3] ${QMAKE_FILE_IN} && $$ssse3_compiler.commands
             QMAKE_EXTRA_COMPILERS += ssse3_compiler
         }
+        avx2 {
+            avx2_compiler.commands = $$QMAKE_CXX -c -Winline
+
+            mac {
+                avx2_compiler.commands += -Xarch_x86_64 -mavx2
+            } else {
+                avx2_compiler.commands += -mavx2
+            }
+
+            avx2_compiler.commands += $(CXXFLAGS) $(INCPATH) ${QMAKE_FILE_IN} -o ${QMAKE_FILE_OUT}
+            avx2_compiler.dependency_type = TYPE_C
+            avx2_compiler.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_BASE}$${first(QMAKE_EXT_OBJ)}
+            avx2_compiler.input = AVX2_SOURCES
+            avx2_compiler.variable_out = OBJECTS
+            avx2_compiler.name = compiling[avx2] ${QMAKE_FILE_IN}
+            silent:avx2_compiler.commands = @echo compiling[avx2] ${QMAKE_FILE_IN} && $$avx2_compiler.commands
+            QMAKE_EXTRA_COMPILERS += avx2_compiler
+        }
         iwmmxt {
             iwmmxt_compiler.commands = $$QMAKE_CXX -c -Winline
             iwmmxt_compiler.commands += -mcpu=iwmmxt
@@ -216,6 +234,7 @@ contains(QMAKE_MAC_XARCH, no) {
         sse: SOURCES += $$SSE_SOURCES
         sse2: SOURCES += $$SSE2_SOURCES
         ssse3: SOURCES += $$SSSE3_SOURCES
+        avx2: SOURCES += $$AVX2_SOURCES
         iwmmxt: SOURCES += $$IWMMXT_SOURCES
     }
 }
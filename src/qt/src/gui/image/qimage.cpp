@@ -3829,6 +3829,8 @@ void qInitImageConversions()
     if (features & SSE2) {
         extern bool convert_ARGB_to_ARGB_PM_inplace_sse2(QImageData *data, Qt::ImageConversionFlags);
         inplace_converter_map[QImage::Format_ARGB32][QImage::Format_ARGB32_Premultiplied] = convert_ARGB_to_ARGB_PM_inplace_sse2;
+        extern void convert_ARGB_PM_to_ARGB_sse2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
+        converter_map[QImage::Format_ARGB32_Premultiplied][QImage::Format_ARGB32] = convert_ARGB_PM_to_ARGB_sse2;
     }
 #endif
 #ifdef QT_HAVE_SSSE3
@@ -104,6 +104,64 @@ bool convert_ARGB_to_ARGB_PM_inplace_sse2(QImageData *data, Qt::ImageConversionF
     return true;
 }
 
+void convert_ARGB_PM_to_ARGB_sse2(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(src->format == QImage::Format_ARGB32_Premultiplied);
+    Q_ASSERT(dest->format == QImage::Format_ARGB32);
+    Q_ASSERT(src->width == dest->width);
+    Q_ASSERT(src->height == dest->height);
+
+    const int spare = src->width & 3;
+    const int iter = src->width >> 2;
+
+    const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+    const __m128i channelMask = _mm_set1_epi32(0xff);
+    const __m128i nullVector = _mm_setzero_si128();
+    const __m128 maxChannel = _mm_set1_ps(255.0f);
+
+    for (int y = 0; y < src->height; ++y) {
+        const __m128i *s = reinterpret_cast<const __m128i*>(src->data + y * src->bytes_per_line);
+        __m128i *d = reinterpret_cast<__m128i*>(dest->data + y * dest->bytes_per_line);
+        const __m128i *end = s + iter;
+
+        for (; s != end; ++s, ++d) {
+            const __m128i srcVector = _mm_loadu_si128(s);
+            const __m128i srcVectorAlpha = _mm_and_si128(srcVector, alphaMask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(srcVectorAlpha, alphaMask)) == 0xffff) {
+                // opaque, data is unchanged
+                _mm_storeu_si128(d, srcVector);
+            } else if (_mm_movemask_epi8(_mm_cmpeq_epi32(srcVectorAlpha, nullVector)) == 0xffff) {
+                // fully transparent
+                _mm_storeu_si128(d, nullVector);
+            } else {
+                // (255 * c) / a, like INV_PREMUL: the product is exact in single precision and
+                // the correctly rounded quotient truncates to the same integer
+                const __m128i alpha = _mm_srli_epi32(srcVector, 24);
+                const __m128 alphaF = _mm_cvtepi32_ps(alpha);
+                const __m128i red = _mm_and_si128(_mm_srli_epi32(srcVector, 16), channelMask);
+                const __m128i green = _mm_and_si128(_mm_srli_epi32(srcVector, 8), channelMask);
+                const __m128i blue = _mm_and_si128(srcVector, channelMask);
+                const __m128i r = _mm_cvttps_epi32(_mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(red), maxChannel), alphaF));
+                const __m128i g = _mm_cvttps_epi32(_mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(green), maxChannel), alphaF));
+                const __m128i b = _mm_cvttps_epi32(_mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(blue), maxChannel), alphaF));
+
+                __m128i result = _mm_or_si128(srcVectorAlpha, _mm_slli_epi32(_mm_and_si128(r, channelMask), 16));
+                result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(g, channelMask), 8));
+                result = _mm_or_si128(result, _mm_and_si128(b, channelMask));
+                // pixels with a null alpha are null
+                result = _mm_andnot_si128(_mm_cmpeq_epi32(alpha, nullVector), result);
+                _mm_storeu_si128(d, result);
+            }
+        }
+
+        const QRgb *p = reinterpret_cast<const QRgb*>(s);
+        const QRgb *pe = p + spare;
+        QRgb *q = reinterpret_cast<QRgb*>(d);
+        for (; p != pe; ++p, ++q)
+            *q = INV_PREMUL(*p);
+    }
+}
+
 QT_END_NAMESPACE
 
 #endif // QT_HAVE_SSE2
@@ -46,10 +46,16 @@
 #include <qiodevice.h>
 #include <qimage.h>
 #include <qlist.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
 #include <qtextcodec.h>
+#include <qthread.h>
+#include <qthreadpool.h>
 #include <qvariant.h>
 #include <qvector.h>
 
+#include <zlib.h>
+
 #ifdef QT_USE_BUNDLED_LIBPNG
 #include <../../3rdparty/libpng/png.h>
 #include <../../3rdparty/libpng/pngconf.h>
@@ -116,12 +122,13 @@ public:
     };
 
     QPngHandlerPrivate(QPngHandler *qq)
-        : gamma(0.0), quality(2), png_ptr(0), info_ptr(0),
+        : gamma(0.0), quality(2), compression(0), png_ptr(0), info_ptr(0),
           end_info(0), row_pointers(0), state(Ready), q(qq)
     { }
 
     float gamma;
     int quality;
+    int compression; // 1 selects the fast encoder, see QPNGImageWriter::setFastEncoding()
     QString description;
     QStringList readTexts;
 
@@ -156,6 +163,7 @@ public:
     void setLooping(int loops=0); // 0 == infinity
     void setFrameDelay(int msecs);
     void setGamma(float);
+    void setFastEncoding(bool);
 
     bool writeImage(const QImage& img, int x, int y);
     bool writeImage(const QImage& img, int quality, const QString &description, int x, int y);
@@ -173,6 +181,7 @@ private:
     int looping;
     int ms_delay;
     float gamma;
+    bool fast_encoding;
 };
 
 static
@@ -609,7 +618,8 @@ QPNGImageWriter::QPNGImageWriter(QIODevice* iod) :
     disposal(Unspecified),
     looping(-1),
     ms_delay(-1),
-    gamma(0.0)
+    gamma(0.0),
+    fast_encoding(false)
 {
 }
 
@@ -637,6 +647,12 @@ void QPNGImageWriter::setGamma(float g)
     gamma = g;
 }
 
+// Trades file size for speed when writing 32-bit images, see write_fast_image_data()
+void QPNGImageWriter::setFastEncoding(bool fast)
+{
+    fast_encoding = fast;
+}
+
 
 #ifndef QT_NO_IMAGE_TEXT
 static void set_text(const QImage &image, png_structp png_ptr, png_infop info_ptr,
@@ -714,6 +730,188 @@ static void set_text(const QImage &image, png_structp png_ptr, png_infop info_pt
 }
 #endif
 
+/*
+  The fast encoder writes the image data of RGB32 and ARGB32 images
+  itself instead of going through libpng: every row gets the cheapest
+  of the None, Sub and Up filters that minimizes the usual sum of
+  absolute residuals, and rows are deflated with level 1 and the RLE
+  strategy. The image is split into bands of rows compressed in
+  parallel; each band is an independent raw deflate stream ending on a
+  byte boundary, so the bands concatenated (plus the zlib header and
+  the combined Adler-32) make up a valid zlib stream for the IDAT chunks.
+*/
+struct QPngFastBand
+{
+    const QImage *image;
+    int firstRow;
+    int lastRow; // exclusive
+    bool isLast;
+    QByteArray data;
+    uLong adler;
+    uLong length;
+    bool ok;
+};
+
+static inline void qpng_convert_row(const QImage &image, int y, uchar *out, int bpp)
+{
+    const QRgb *in = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+    const int width = image.width();
+    for (int x = 0; x < width; ++x) {
+        const QRgb pixel = in[x];
+        *out++ = qRed(pixel);
+        *out++ = qGreen(pixel);
+        *out++ = qBlue(pixel);
+        if (bpp == 4)
+            *out++ = qAlpha(pixel);
+    }
+}
+
+static inline uint qpng_residual(uchar value)
+{
+    return qAbs(int(static_cast<signed char>(value)));
+}
+
+static void qpng_encode_band(QPngFastBand *band)
+{
+    band->ok = false;
+
+    const QImage &image = *band->image;
+    const int bpp = image.hasAlphaChannel() ? 4 : 3;
+    const int rowBytes = image.width() * bpp;
+
+    QByteArray rows(2 * rowBytes, 0);
+    uchar *prev = reinterpret_cast<uchar *>(rows.data());
+    uchar *cur = prev + rowBytes;
+    bool hasPrev = band->firstRow > 0;
+    if (hasPrev)
+        qpng_convert_row(image, band->firstRow - 1, prev, bpp);
+
+    QByteArray filtered;
+    filtered.resize((band->lastRow - band->firstRow) * (rowBytes + 1));
+    uchar *out = reinterpret_cast<uchar *>(filtered.data());
+
+    for (int y = band->firstRow; y < band->lastRow; ++y) {
+        qpng_convert_row(image, y, cur, bpp);
+
+        uint sumNone = 0, sumSub = 0, sumUp = 0;
+        for (int i = 0; i < rowBytes; ++i) {
+            const uchar left = i >= bpp ? cur[i - bpp] : 0;
+            const uchar up = hasPrev ? prev[i] : 0;
+            sumNone += qpng_residual(cur[i]);
+            sumSub += qpng_residual(cur[i] - left);
+            sumUp += qpng_residual(cur[i] - up);
+        }
+
+        if (sumSub < sumNone && sumSub <= sumUp) {
+            *out++ = PNG_FILTER_VALUE_SUB;
+            for (int i = 0; i < rowBytes; ++i)
+                *out++ = cur[i] - (i >= bpp ? cur[i - bpp] : 0);
+        } else if (hasPrev && sumUp < sumNone) {
+            *out++ = PNG_FILTER_VALUE_UP;
+            for (int i = 0; i < rowBytes; ++i)
+                *out++ = cur[i] - prev[i];
+        } else {
+            *out++ = PNG_FILTER_VALUE_NONE;
+            memcpy(out, cur, rowBytes);
+            out += rowBytes;
+        }
+
+        qSwap(prev, cur);
+        hasPrev = true;
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, 1, Z_DEFLATED, -MAX_WBITS, 8, Z_RLE) != Z_OK)
+        return;
+
+    // The zlib header goes in front of the first band
+    const int headerSize = band->firstRow ? 0 : 2;
+    band->data.resize(headerSize + deflateBound(&stream, filtered.size()) + 16);
+    if (headerSize) {
+        band->data[0] = char(0x78); // deflate, 32K window
+        band->data[1] = char(0x01); // fastest compression, no dictionary
+    }
+
+    stream.next_in = reinterpret_cast<Bytef *>(filtered.data());
+    stream.avail_in = filtered.size();
+    stream.next_out = reinterpret_cast<Bytef *>(band->data.data() + headerSize);
+    stream.avail_out = band->data.size() - headerSize;
+
+    // A sync flush ends the band on a byte boundary without ending the stream
+    const int result = deflate(&stream, band->isLast ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool complete = band->isLast ? result == Z_STREAM_END
+                                       : (result == Z_OK && !stream.avail_in && stream.avail_out);
+    band->data.resize(band->data.size() - stream.avail_out);
+    deflateEnd(&stream);
+    if (!complete)
+        return;
+
+    band->adler = adler32(adler32(0L, Z_NULL, 0), reinterpret_cast<const Bytef *>(filtered.constData()), filtered.size());
+    band->length = filtered.size();
+    band->ok = true;
+}
+
+class QPngBandEncoder : public QRunnable
+{
+public:
+    QPngBandEncoder(QPngFastBand *band, QSemaphore *done) : band(band), done(done) { }
+    void run()
+    {
+        qpng_encode_band(band);
+        done->release();
+    }
+
+private:
+    QPngFastBand *band;
+    QSemaphore *done;
+};
+
+// Returns false without writing anything if encoding failed
+static bool write_fast_image_data(png_structp png_ptr, const QImage &image)
+{
+    // Bands of at least 128 rows, at most one per core
+    const int height = image.height();
+    const int bandCount = qBound(1, height / 128, QThread::idealThreadCount());
+
+    QVector<QPngFastBand> bands(bandCount);
+    for (int i = 0; i < bandCount; ++i) {
+        QPngFastBand &band = bands[i];
+        band.image = &image;
+        band.firstRow = height * i / bandCount;
+        band.lastRow = height * (i + 1) / bandCount;
+        band.isLast = i == bandCount - 1;
+        band.ok = false;
+    }
+
+    // The first band is encoded right here; so are the others when the
+    // global pool is busy (e.g. when called from one of its threads)
+    QSemaphore done;
+    for (int i = 1; i < bandCount; ++i) {
+        QPngBandEncoder *encoder = new QPngBandEncoder(&bands[i], &done);
+        if (!QThreadPool::globalInstance()->tryStart(encoder)) {
+            encoder->run();
+            delete encoder;
+        }
+    }
+    qpng_encode_band(&bands[0]);
+    done.acquire(bandCount - 1);
+
+    uLong adler = adler32(0L, Z_NULL, 0);
+    for (int i = 0; i < bandCount; ++i) {
+        if (!bands.at(i).ok)
+            return false;
+        adler = adler32_combine(adler, bands.at(i).adler, bands.at(i).length);
+    }
+
+    const uchar trailer[4] = { uchar(adler >> 24), uchar(adler >> 16), uchar(adler >> 8), uchar(adler) };
+    bands.last().data.append(reinterpret_cast<const char *>(trailer), 4);
+
+    for (int i = 0; i < bandCount; ++i)
+        png_write_chunk(png_ptr, (png_byte*)"IDAT", (png_bytep)bands.at(i).data.constData(), bands.at(i).data.size());
+    return true;
+}
+
 bool QPNGImageWriter::writeImage(const QImage& image, int off_x, int off_y)
 {
     return writeImage(image, -1, QString(), off_x, off_y);
@@ -866,6 +1064,15 @@ bool Q_INTERNAL_WIN_NO_THROW QPNGImageWriter::writeImage(const QImage& image, in
         png_write_chunk(png_ptr, (png_byte*)"gIFg", data, 4);
     }
 
+    if (fast_encoding && frames_written == 0
+        && (image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32)
+        && write_fast_image_data(png_ptr, image)) {
+        png_write_chunk(png_ptr, (png_byte*)"IEND", 0, 0);
+        frames_written++;
+        png_destroy_write_struct(&png_ptr, &info_ptr);
+        return true;
+    }
+
     int height = image.height();
     int width = image.width();
     switch (image.format()) {
@@ -906,9 +1113,10 @@ bool Q_INTERNAL_WIN_NO_THROW QPNGImageWriter::writeImage(const QImage& image, in
 }
 
 static bool write_png_image(const QImage &image, QIODevice *device,
-                            int quality, float gamma, const QString &description)
+                            int quality, float gamma, const QString &description, bool fast)
 {
     QPNGImageWriter writer(device);
+    writer.setFastEncoding(fast);
     if (quality >= 0) {
         quality = qMin(quality, 100);
         quality = (100-quality) * 9 / 91; // map [0,100] -> [9,0]
@@ -961,7 +1169,7 @@ bool QPngHandler::read(QImage *image)
 
 bool QPngHandler::write(const QImage &image)
 {
-    return write_png_image(image, device(), d->quality, d->gamma, d->description);
+    return write_png_image(image, device(), d->quality, d->gamma, d->description, d->compression == 1);
 }
 
 bool QPngHandler::supportsOption(ImageOption option) const
@@ -970,6 +1178,7 @@ bool QPngHandler::supportsOption(ImageOption option) const
         || option == Description
         || option == ImageFormat
         || option == Quality
+        || option == CompressionRatio
         || option == Size;
 }
 
@@ -984,6 +1193,8 @@ QVariant QPngHandler::option(ImageOption option) const
         return d->gamma;
     else if (option == Quality)
         return d->quality;
+    else if (option == CompressionRatio)
+        return d->compression;
     else if (option == Description)
         return d->description;
     else if (option == Size)
@@ -1000,6 +1211,8 @@ void QPngHandler::setOption(ImageOption option, const QVariant &value)
         d->gamma = value.toFloat();
     else if (option == Quality)
         d->quality = value.toInt();
+    else if (option == CompressionRatio)
+        d->compression = value.toInt();
     else if (option == Description)
         d->description = value.toString();
 }
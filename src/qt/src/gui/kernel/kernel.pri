@@ -271,8 +271,12 @@ qpa {
 
 	HEADERS += kernel/qminimalintegration.h
 	HEADERS += kernel/qminimalwindowsurface.h
+	HEADERS += kernel/qheadlessintegration.h
+	HEADERS += kernel/qheadlesswindowsurface.h
 	SOURCES += kernel/qminimalintegration.cpp
 	SOURCES += kernel/qminimalwindowsurface.cpp
+	SOURCES += kernel/qheadlessintegration.cpp
+	SOURCES += kernel/qheadlesswindowsurface.cpp
 }
 
 unix:qpa {
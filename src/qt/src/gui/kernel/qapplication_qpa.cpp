@@ -71,6 +71,7 @@
 #include "qdesktopwidget_qpa_p.h"
 
 #include "qminimalintegration.h"
+#include "qheadlessintegration.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -473,7 +474,12 @@ QPlatformNativeInterface *QApplication::platformNativeInterface()
 
 static void init_platform(const QString &name, const QString &platformPluginPath)
 {
-    QApplicationPrivate::platform_integration = new QMinimalIntegration;
+    Q_UNUSED(platformPluginPath);
+    // Plugins are not loaded; the platform is one of the built-in ones
+    if (name == QLatin1String("minimal"))
+        QApplicationPrivate::platform_integration = new QMinimalIntegration;
+    else
+        QApplicationPrivate::platform_integration = new QHeadlessIntegration;
 }
 
 
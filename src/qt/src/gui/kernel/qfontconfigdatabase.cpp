@@ -44,7 +44,14 @@
 #include <QtCore/QList>
 #include <QtGui/private/qfont_p.h>
 
+#include <QtCore/QBuffer>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDirIterator>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryFile>
 
 #include <QtGui/private/qapplication_p.h>
 #include <QtGui/QPlatformScreen>
@@ -60,6 +67,8 @@
 
 #include <fontconfig/fontconfig.h>
 
+#include <stdio.h>
+
 #define SimplifiedChineseCsbBit 18
 #define TraditionalChineseCsbBit 20
 #define JapaneseCsbBit 17
@@ -294,8 +303,206 @@ static const char *getFcFamilyForStyleHint(const QFont::StyleHint style)
     return stylehint;
 }
 
-void QFontconfigDatabase::populateFontDatabase()
+// Fonts registered by populateFontDatabase(), as listed by fontconfig or
+// read back from a snapshot.
+struct QFontconfigFontEntry
+{
+    QString family;
+    QString foundry;
+    int weight;
+    int style;
+    int stretch;
+    bool antialias;
+    bool scalable;
+    double pixelSize;
+    quint64 writingSystems;
+    QString fileName;
+    int index;
+};
+
+QDataStream &operator<<(QDataStream &stream, const QFontconfigFontEntry &entry)
+{
+    stream << entry.family << entry.foundry
+           << qint32(entry.weight) << qint32(entry.style) << qint32(entry.stretch)
+           << entry.antialias << entry.scalable << entry.pixelSize
+           << entry.writingSystems << entry.fileName << qint32(entry.index);
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, QFontconfigFontEntry &entry)
+{
+    qint32 weight, style, stretch, index;
+    stream >> entry.family >> entry.foundry
+           >> weight >> style >> stretch
+           >> entry.antialias >> entry.scalable >> entry.pixelSize
+           >> entry.writingSystems >> entry.fileName >> index;
+    entry.weight = weight;
+    entry.style = style;
+    entry.stretch = stretch;
+    entry.index = index;
+    return stream;
+}
+
+// With QT_QPA_FONTDIR set, only the fonts of that directory are known to
+// fontconfig, both for registration and for fallbacks. The configuration
+// files are still loaded for their substitution rules, but the fonts of the
+// directories they list are never scanned.
+static FcConfig *pinnedConfig()
+{
+    static bool initialized = false;
+    static FcConfig *config = 0;
+    if (!initialized) {
+        initialized = true;
+        const QByteArray dir = qgetenv("QT_QPA_FONTDIR");
+        if (!dir.isEmpty()) {
+            config = FcInitLoadConfig();
+            if (!FcConfigAppFontAddDir(config, (const FcChar8 *)dir.constData()))
+                qWarning("QFontconfigDatabase: Unable to add fonts from %s", dir.constData());
+        }
+    }
+    return config;
+}
+
+// Configuration used for pattern substitution. If the fonts were read from
+// a snapshot, the configuration files are loaded without scanning fonts.
+static bool fontsFromSnapshot = false;
+
+static FcConfig *substitutionConfig()
+{
+    if (FcConfig *config = pinnedConfig())
+        return config;
+    if (!fontsFromSnapshot)
+        return 0;
+    static FcConfig *rules = FcInitLoadConfig();
+    return rules;
+}
+
+static const quint32 snapshotMagic = 0x51464353; // "QFCS"
+static const quint32 snapshotVersion = 1;
+
+// Paths whose modification time invalidates a snapshot: the font directories
+// and the fontconfig configuration files.
+static QStringList snapshotDependencies()
+{
+    QStringList paths;
+    const QByteArray pinnedDir = qgetenv("QT_QPA_FONTDIR");
+    if (!pinnedDir.isEmpty()) {
+        const QString dir = QFile::decodeName(pinnedDir);
+        paths << dir;
+        QDirIterator it(dir, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext())
+            paths << it.next();
+        return paths;
+    }
+
+    FcStrList *list = FcConfigGetFontDirs(0);
+    while (FcChar8 *path = FcStrListNext(list))
+        paths << QFile::decodeName((const char *)path);
+    FcStrListDone(list);
+
+    list = FcConfigGetConfigFiles(0);
+    while (FcChar8 *path = FcStrListNext(list))
+        paths << QFile::decodeName((const char *)path);
+    FcStrListDone(list);
+    return paths;
+}
+
+static qint64 modificationTime(const QString &path)
+{
+    QFileInfo info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+static bool loadSnapshot(const QString &fileName, QList<QFontconfigFontEntry> *entries)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() <= 0)
+        return false;
+
+    uchar *data = file.map(0, file.size());
+    QByteArray bytes = data
+        ? QByteArray::fromRawData(reinterpret_cast<const char *>(data), file.size())
+        : file.readAll();
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::ReadOnly);
+
+    QDataStream stream(&buffer);
+    stream.setVersion(QDataStream::Qt_4_8);
+
+    quint32 magic, version;
+    QByteArray pinnedDir;
+    stream >> magic >> version;
+    bool valid = magic == snapshotMagic && version == snapshotVersion;
+    if (valid) {
+        stream >> pinnedDir;
+        valid = pinnedDir == qgetenv("QT_QPA_FONTDIR");
+    }
+
+    quint32 count = 0;
+    if (valid) {
+        stream >> count;
+        for (quint32 i = 0; valid && i < count; ++i) {
+            QString path;
+            qint64 mtime;
+            stream >> path >> mtime;
+            valid = stream.status() == QDataStream::Ok && modificationTime(path) == mtime;
+        }
+    }
+
+    if (valid) {
+        stream >> count;
+        for (quint32 i = 0; stream.status() == QDataStream::Ok && i < count; ++i) {
+            QFontconfigFontEntry entry;
+            stream >> entry;
+            entries->append(entry);
+        }
+        valid = stream.status() == QDataStream::Ok;
+        if (!valid)
+            entries->clear();
+    }
+
+    buffer.close();
+    bytes.clear();
+    if (data)
+        file.unmap(data);
+    return valid;
+}
+
+// Written to a temporary file first and renamed over the snapshot, so that
+// another process never loads a partially written one.
+static void saveSnapshot(const QString &fileName, const QList<QFontconfigFontEntry> &entries)
+{
+    QTemporaryFile file(fileName + QLatin1String(".XXXXXX"));
+    if (!file.open()) {
+        qWarning("QFontconfigDatabase: Unable to write font snapshot %s", qPrintable(fileName));
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_8);
+    stream << snapshotMagic << snapshotVersion << qgetenv("QT_QPA_FONTDIR");
+
+    const QStringList dependencies = snapshotDependencies();
+    stream << quint32(dependencies.count());
+    for (int i = 0; i < dependencies.count(); ++i)
+        stream << dependencies.at(i) << modificationTime(dependencies.at(i));
+
+    stream << quint32(entries.count());
+    for (int i = 0; i < entries.count(); ++i)
+        stream << entries.at(i);
+
+    file.close();
+    if (stream.status() != QDataStream::Ok || file.error() != QFile::NoError
+        || ::rename(QFile::encodeName(file.fileName()).constData(), QFile::encodeName(fileName).constData()) != 0) {
+        qWarning("QFontconfigDatabase: Unable to write font snapshot %s", qPrintable(fileName));
+        return;
+    }
+    file.setAutoRemove(false);
+}
+
+static QList<QFontconfigFontEntry> listFonts()
 {
+    QList<QFontconfigFontEntry> entries;
     FcFontSet  *fonts;
 
     QString familyName;
@@ -327,12 +534,12 @@ void QFontconfigDatabase::populateFontDatabase()
             FcObjectSetAdd(os, *p);
             ++p;
         }
-        fonts = FcFontList(0, pattern, os);
+        fonts = FcFontList(pinnedConfig(), pattern, os);
         FcObjectSetDestroy(os);
         FcPatternDestroy(pattern);
     }
 
-    for (int i = 0; i < fonts->nfont; i++) {
+    for (int i = 0; fonts && i < fonts->nfont; i++) {
         if (FcPatternGetString(fonts->fonts[i], FC_FAMILY, 0, &value) != FcResultMatch)
             continue;
         //         capitalize(value);
@@ -406,10 +613,6 @@ void QFontconfigDatabase::populateFontDatabase()
         }
 #endif
 
-        FontFile *fontFile = new FontFile;
-        fontFile->fileName = QLatin1String((const char *)file_value);
-        fontFile->indexValue = indexValue;
-
         QFont::Style style = (slant_value == FC_SLANT_ITALIC)
                          ? QFont::StyleItalic
                          : ((slant_value == FC_SLANT_OBLIQUE)
@@ -425,11 +628,66 @@ void QFontconfigDatabase::populateFontDatabase()
         }
 
         QFont::Stretch stretch = QFont::Unstretched;
-        QPlatformFontDatabase::registerFont(familyName,QLatin1String((const char *)foundry_value),weight,style,stretch,antialias,scalable,pixel_size,writingSystems,fontFile);
+
+        QFontconfigFontEntry entry;
+        entry.family = familyName;
+        entry.foundry = QLatin1String((const char *)foundry_value);
+        entry.weight = weight;
+        entry.style = style;
+        entry.stretch = stretch;
+        entry.antialias = antialias;
+        entry.scalable = scalable;
+        entry.pixelSize = pixel_size;
+        entry.writingSystems = 0;
+        for (int j = 0; j < QFontDatabase::WritingSystemsCount; ++j) {
+            if (writingSystems.supported(QFontDatabase::WritingSystem(j)))
+                entry.writingSystems |= Q_UINT64_C(1) << j;
+        }
+        entry.fileName = QLatin1String((const char *)file_value);
+        entry.index = indexValue;
+        entries.append(entry);
 //        qDebug() << familyName << (const char *)foundry_value << weight << style << &writingSystems << scalable << true << pixel_size;
     }
 
-    FcFontSetDestroy (fonts);
+    if (fonts)
+        FcFontSetDestroy (fonts);
+
+    return entries;
+}
+
+// A snapshot of the registered fonts is kept in the file named by
+// QT_QPA_FONTCONFIG_SNAPSHOT, if set. It is reused as long as none of the
+// font directories and configuration files it was built from has changed,
+// which saves listing and classifying every font through fontconfig.
+void QFontconfigDatabase::populateFontDatabase()
+{
+    const QString snapshotFile = QFile::decodeName(qgetenv("QT_QPA_FONTCONFIG_SNAPSHOT"));
+
+    QList<QFontconfigFontEntry> entries;
+    fontsFromSnapshot = !snapshotFile.isEmpty() && loadSnapshot(snapshotFile, &entries);
+    if (!fontsFromSnapshot) {
+        entries = listFonts();
+        if (!snapshotFile.isEmpty())
+            saveSnapshot(snapshotFile, entries);
+    }
+
+    for (int i = 0; i < entries.count(); ++i) {
+        const QFontconfigFontEntry &entry = entries.at(i);
+        QSupportedWritingSystems writingSystems;
+        for (int j = 0; j < QFontDatabase::WritingSystemsCount; ++j) {
+            if (entry.writingSystems & (Q_UINT64_C(1) << j))
+                writingSystems.setSupported(QFontDatabase::WritingSystem(j));
+        }
+
+        FontFile *fontFile = new FontFile;
+        fontFile->fileName = entry.fileName;
+        fontFile->indexValue = entry.index;
+
+        QPlatformFontDatabase::registerFont(entry.family, entry.foundry, QFont::Weight(entry.weight),
+                                            QFont::Style(entry.style), QFont::Stretch(entry.stretch),
+                                            entry.antialias, entry.scalable, entry.pixelSize,
+                                            writingSystems, fontFile);
+    }
 
     struct FcDefaultFont {
         const char *qtname;
@@ -500,7 +758,7 @@ QFontEngine *QFontconfigDatabase::fontEngine(const QFontDef &f, QUnicodeTables::
 
     QFontEngineFT::HintStyle default_hint_style;
 
-    if (FcConfigSubstitute(0,pattern,FcMatchPattern)) {
+    if (FcConfigSubstitute(substitutionConfig(),pattern,FcMatchPattern)) {
 
         //hinting
         int hint_style = 0;
@@ -576,11 +834,11 @@ QStringList QFontconfigDatabase::fallbacksForFamily(const QString family, const
         FcPatternAddWeak(pattern, FC_FAMILY, value, FcTrue);
     }
 
-    FcConfigSubstitute(0, pattern, FcMatchPattern);
-    FcConfigSubstitute(0, pattern, FcMatchFont);
+    FcConfigSubstitute(pinnedConfig(), pattern, FcMatchPattern);
+    FcConfigSubstitute(pinnedConfig(), pattern, FcMatchFont);
 
     FcResult result = FcResultMatch;
-    FcFontSet *fontSet = FcFontSort(0,pattern,FcFalse,0,&result);
+    FcFontSet *fontSet = FcFontSort(pinnedConfig(),pattern,FcFalse,0,&result);
 
     if (fontSet && result == FcResultMatch)
     {
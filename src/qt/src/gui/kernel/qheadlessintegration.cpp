@@ -0,0 +1,168 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the plugins of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qheadlessintegration.h"
+#include "qheadlesswindowsurface.h"
+
+#include "qfontconfigdatabase.h"
+
+#include <QtGui/private/qpixmap_raster_p.h>
+#include <QtGui/QPlatformWindow>
+
+QT_BEGIN_NAMESPACE
+
+static QHeadlessScreen *headlessPrimaryScreen = 0;
+
+QSize QHeadlessScreen::physicalSize() const
+{
+    // Derived on every call so that changing the resolution at run-time
+    // is picked up by qt_defaultDpi() and everything sized in points
+    return QSize(qRound(mGeometry.width() * 25.4 / mDpi),
+                 qRound(mGeometry.height() * 25.4 / mDpi));
+}
+
+QHeadlessIntegration::QHeadlessIntegration()
+{
+    QHeadlessScreen *mPrimaryScreen = new QHeadlessScreen();
+
+    // Simulate typical desktop screen
+    mPrimaryScreen->mGeometry = QRect(0, 0, 1024, 768);
+    mPrimaryScreen->mDepth = 32;
+    mPrimaryScreen->mFormat = QImage::Format_ARGB32_Premultiplied;
+
+    bool ok;
+    int dpi = qgetenv("QT_QPA_HEADLESS_DPI").toInt(&ok);
+    if (ok && dpi > 0)
+        mPrimaryScreen->mDpi = dpi;
+    qreal ratio = qgetenv("QT_QPA_HEADLESS_DEVICE_PIXEL_RATIO").toDouble(&ok);
+    if (ok && ratio > 0)
+        mPrimaryScreen->mDevicePixelRatio = ratio;
+
+    mScreens.append(mPrimaryScreen);
+    headlessPrimaryScreen = mPrimaryScreen;
+}
+
+QHeadlessIntegration::~QHeadlessIntegration()
+{
+    headlessPrimaryScreen = 0;
+    qDeleteAll(mScreens);
+}
+
+QHeadlessScreen *QHeadlessIntegration::primaryScreen()
+{
+    return headlessPrimaryScreen;
+}
+
+bool QHeadlessIntegration::hasCapability(QPlatformIntegration::Capability cap) const
+{
+    switch (cap) {
+    case ThreadedPixmaps: return true;
+    default: return QPlatformIntegration::hasCapability(cap);
+    }
+}
+
+QPixmapData *QHeadlessIntegration::createPixmapData(QPixmapData::PixelType type) const
+{
+    return new QRasterPixmapData(type);
+}
+
+QPlatformWindow *QHeadlessIntegration::createPlatformWindow(QWidget *widget, WId winId) const
+{
+    Q_UNUSED(winId);
+    return new QPlatformWindow(widget);
+}
+
+QWindowSurface *QHeadlessIntegration::createWindowSurface(QWidget *widget, WId winId) const
+{
+    Q_UNUSED(winId);
+    return new QHeadlessWindowSurface(widget);
+}
+
+QPlatformFontDatabase *QHeadlessIntegration::fontDatabase() const
+{
+    static QPlatformFontDatabase *db = 0;
+    if (!db) {
+        db = new QFontconfigDatabase();
+    }
+    return db;
+}
+
+/*!
+    \internal
+
+    Sets the logical resolution of the headless screen to \a dpi dots per inch.
+*/
+Q_GUI_EXPORT void qt_headless_set_dpi(int dpi)
+{
+    if (headlessPrimaryScreen && dpi > 0)
+        headlessPrimaryScreen->mDpi = dpi;
+}
+
+/*!
+    \internal
+
+    Sets the number of device pixels per logical pixel that offscreen
+    renderings of the headless screen are produced at.
+*/
+Q_GUI_EXPORT void qt_headless_set_device_pixel_ratio(qreal ratio)
+{
+    if (headlessPrimaryScreen && ratio > 0)
+        headlessPrimaryScreen->mDevicePixelRatio = ratio;
+}
+
+Q_GUI_EXPORT qreal qt_headless_device_pixel_ratio()
+{
+    return headlessPrimaryScreen ? headlessPrimaryScreen->mDevicePixelRatio : qreal(1);
+}
+
+/*!
+    \internal
+
+    Makes \a window paint directly into \a target instead of a backing
+    store; passing 0 restores the default. The image is not owned.
+*/
+Q_GUI_EXPORT void qt_headless_set_render_target(QWidget *window, QImage *target)
+{
+    QHeadlessWindowSurface::setRenderTarget(window, target);
+}
+
+QT_END_NAMESPACE
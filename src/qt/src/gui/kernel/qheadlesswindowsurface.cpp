@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of the plugins of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this
+** file. Please review the following information to ensure the GNU Lesser
+** General Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights. These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU General
+** Public License version 3.0 as published by the Free Software Foundation
+** and appearing in the file LICENSE.GPL included in the packaging of this
+** file. Please review the following information to ensure the GNU General
+** Public License version 3.0 requirements will be met:
+** http://www.gnu.org/copyleft/gpl.html.
+**
+** Other Usage
+** Alternatively, this file may be used in accordance with the terms and
+** conditions contained in a signed written agreement between you and Nokia.
+**
+**
+**
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include "qheadlesswindowsurface.h"
+#include <QtCore/qhash.h>
+#include <QtGui/private/qapplication_p.h>
+
+QT_BEGIN_NAMESPACE
+
+typedef QHash<const QWidget *, QImage *> QHeadlessRenderTargetHash;
+Q_GLOBAL_STATIC(QHeadlessRenderTargetHash, headlessRenderTargets)
+Q_GLOBAL_STATIC(QImage, headlessScratchImage)
+
+QHeadlessWindowSurface::QHeadlessWindowSurface(QWidget *window)
+    : QWindowSurface(window)
+{
+}
+
+QHeadlessWindowSurface::~QHeadlessWindowSurface()
+{
+    headlessRenderTargets()->remove(window());
+}
+
+QPaintDevice *QHeadlessWindowSurface::paintDevice()
+{
+    if (QImage *target = headlessRenderTargets()->value(window()))
+        return target;
+
+    // Windows are painted one at a time, so the scratch image only has to
+    // be as large as the largest of them
+    QImage *scratch = headlessScratchImage();
+    const QSize required = size().expandedTo(scratch->size());
+    if (scratch->size() != required) {
+        QImage::Format format = QApplicationPrivate::platformIntegration()->screens().first()->format();
+        *scratch = QImage(required, format);
+    }
+    return scratch;
+}
+
+void QHeadlessWindowSurface::flush(QWidget *widget, const QRegion &region, const QPoint &offset)
+{
+    Q_UNUSED(widget);
+    Q_UNUSED(region);
+    Q_UNUSED(offset);
+}
+
+void QHeadlessWindowSurface::resize(const QSize &size)
+{
+    // Only the geometry is recorded; memory is committed when painting
+    QWindowSurface::resize(size);
+}
+
+void QHeadlessWindowSurface::endPaint(const QRegion &region)
+{
+    QWindowSurface::endPaint(region);
+
+    // A window larger than the screen (a full page laid out in one go) must
+    // not keep its memory committed for every later paint
+    QImage *scratch = headlessScratchImage();
+    const QSize screenSize = QApplicationPrivate::platformIntegration()->screens().first()->geometry().size();
+    if (scratch->width() > screenSize.width() || scratch->height() > screenSize.height())
+        *scratch = QImage();
+}
+
+void QHeadlessWindowSurface::setRenderTarget(QWidget *window, QImage *target)
+{
+    if (target)
+        headlessRenderTargets()->insert(window, target);
+    else
+        headlessRenderTargets()->remove(window);
+}
+
+QT_END_NAMESPACE
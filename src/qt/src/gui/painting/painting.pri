@@ -230,6 +230,7 @@ if(mmx|3dnow|sse|sse2|iwmmxt) {
     SSE_SOURCES += painting/qdrawhelper_sse.cpp
     SSE2_SOURCES += painting/qdrawhelper_sse2.cpp
     SSSE3_SOURCES += painting/qdrawhelper_ssse3.cpp
+    AVX2_SOURCES += painting/qdrawhelper_avx2.cpp
     IWMMXT_SOURCES += painting/qdrawhelper_iwmmxt.cpp
 }
 
@@ -643,6 +643,12 @@ static inline uint interpolate_4_pixels_16(uint tl, uint tr, uint bl, uint br, i
     return (((tlrb + trrb + blrb + brrb) >> 8) & 0x00ff00ff) | ((tlag + trag + blag + brag) & 0xff00ff00);
 }
 
+// Vertical pass of the bilinear upscaling, see qt_bilinear_interpolate_rows_avx2()
+typedef void (QT_FASTCALL *BilinearInterpolateRowsFunc)(quint32 *rb, quint32 *ag,
+                                                        const uint *s1, const uint *s2,
+                                                        int count, int disty);
+static BilinearInterpolateRowsFunc qt_bilinear_interpolate_rows = 0;
+
 #if defined(QT_ALWAYS_HAVE_SSE2)
 #define interpolate_4_pixels_16_sse2(tl, tr, bl, br, distx, disty, colorMask, v_256, b)  \
 { \
@@ -821,6 +827,14 @@ const uint * QT_FASTCALL fetchTransformedBilinear(uint *buffer, const Operator *
 
                 if (blendType != BlendTransformedBilinearTiled &&
                         (format == QImage::Format_ARGB32_Premultiplied || format == QImage::Format_RGB32)) {
+                    if (qt_bilinear_interpolate_rows && lim - f >= 8) {
+                        // Wider version of the loops below, 8 pixels at a time
+                        const int n = (lim - f) & ~7;
+                        qt_bilinear_interpolate_rows(&intermediate_buffer[0][f], &intermediate_buffer[1][f],
+                                                     (const uint *)(s1) + x, (const uint *)(s2) + x, n, disty);
+                        f += n;
+                        x += n;
+                    }
 #if defined(QT_ALWAYS_HAVE_SSE2)
                     const __m128i disty_ = _mm_set1_epi16(disty);
                     const __m128i idisty_ = _mm_set1_epi16(idisty);
@@ -7771,6 +7785,22 @@ void qInitDrawhelperAsm()
     }
 #endif // SSSE3
 
+#ifdef QT_HAVE_AVX2
+    if (features & AVX2) {
+        extern void qt_blend_argb32_on_argb32_avx2(uchar *destPixels, int dbpl,
+                                                   const uchar *srcPixels, int sbpl,
+                                                   int w, int h,
+                                                   int const_alpha);
+        extern void QT_FASTCALL qt_bilinear_interpolate_rows_avx2(quint32 *rb, quint32 *ag,
+                                                                  const uint *s1, const uint *s2,
+                                                                  int count, int disty);
+
+        qBlendFunctions[QImage::Format_RGB32][QImage::Format_ARGB32_Premultiplied] = qt_blend_argb32_on_argb32_avx2;
+        qBlendFunctions[QImage::Format_ARGB32_Premultiplied][QImage::Format_ARGB32_Premultiplied] = qt_blend_argb32_on_argb32_avx2;
+        qt_bilinear_interpolate_rows = qt_bilinear_interpolate_rows_avx2;
+    }
+#endif // AVX2
+
 #endif // SSE2
 
 #ifdef QT_HAVE_SSE
@@ -7812,6 +7842,17 @@ void qInitDrawhelperAsm()
     }
 #endif
 
+#ifdef QT_HAVE_AVX2
+    if ((features & AVX2) && functionForModeAsm) {
+        extern void QT_FASTCALL comp_func_SourceOver_avx2(uint *destPixels,
+                                                          const uint *srcPixels,
+                                                          int length,
+                                                          uint const_alpha);
+
+        functionForModeAsm[0] = comp_func_SourceOver_avx2;
+    }
+#endif // AVX2
+
 #ifdef QT_HAVE_IWMMXT
     if (features & IWMMXT) {
         functionForModeAsm = qt_functionForMode_IWMMXT;
@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Copyright (C) 2012 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/qdrawhelper_x86_p.h>
+
+#ifdef QT_HAVE_AVX2
+
+#include <private/qsimd_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+ * The AVX2 counterparts of BYTE_MUL_SSE2() and BLEND_SOURCE_OVER_ARGB32_SSE2(),
+ * working on 8 pixels at a time. Each 32 bits component of alphaChannel must be
+ * in the form 0x00AA00AA, colorMask must be 0x00ff00ff and half 0x0080 on each
+ * 16 bits component.
+ */
+#define BYTE_MUL_AVX2(result, pixelVector, alphaChannel, colorMask, half) \
+{ \
+    __m256i pixelVectorAG = _mm256_srli_epi16(pixelVector, 8); \
+    __m256i pixelVectorRB = _mm256_and_si256(pixelVector, colorMask); \
+ \
+    pixelVectorAG = _mm256_mullo_epi16(pixelVectorAG, alphaChannel); \
+    pixelVectorRB = _mm256_mullo_epi16(pixelVectorRB, alphaChannel); \
+ \
+    /* X/255 ~= (X + X/256 + rounding)/256, as in BYTE_MUL() */ \
+    pixelVectorRB = _mm256_add_epi16(pixelVectorRB, _mm256_srli_epi16(pixelVectorRB, 8)); \
+    pixelVectorRB = _mm256_add_epi16(pixelVectorRB, half); \
+    pixelVectorAG = _mm256_add_epi16(pixelVectorAG, _mm256_srli_epi16(pixelVectorAG, 8)); \
+    pixelVectorAG = _mm256_add_epi16(pixelVectorAG, half); \
+ \
+    pixelVectorRB = _mm256_srli_epi16(pixelVectorRB, 8); \
+    pixelVectorAG = _mm256_andnot_si256(colorMask, pixelVectorAG); \
+ \
+    result = _mm256_or_si256(pixelVectorAG, pixelVectorRB); \
+}
+
+inline static void blend_pixel(quint32 &dst, const quint32 src)
+{
+    if (src >= 0xff000000)
+        dst = src;
+    else if (src != 0)
+        dst = src + BYTE_MUL(dst, qAlpha(~src));
+}
+
+inline static void blend_pixel(quint32 &dst, const quint32 src, const int const_alpha)
+{
+    if (src != 0) {
+        const quint32 s = BYTE_MUL(src, const_alpha);
+        dst = s + BYTE_MUL(dst, qAlpha(~s));
+    }
+}
+
+// result = s + d * (1 - alpha), with shortcuts for opaque and transparent runs
+static void blend_source_over_argb32_avx2(quint32 *dst, const quint32 *src, int length)
+{
+    const __m256i alphaMask = _mm256_set1_epi32(0xff000000);
+    const __m256i half = _mm256_set1_epi16(0x80);
+    const __m256i one = _mm256_set1_epi16(0xff);
+    const __m256i colorMask = _mm256_set1_epi32(0x00ff00ff);
+
+    int x = 0;
+    for (; x < length - 7; x += 8) {
+        const __m256i srcVector = _mm256_loadu_si256((const __m256i *)&src[x]);
+        const __m256i srcVectorAlpha = _mm256_and_si256(srcVector, alphaMask);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(srcVectorAlpha, alphaMask)) == -1) {
+            // all opaque
+            _mm256_storeu_si256((__m256i *)&dst[x], srcVector);
+        } else if (!_mm256_testz_si256(srcVectorAlpha, srcVectorAlpha)) {
+            // not fully transparent
+            __m256i alphaChannel = _mm256_srli_epi32(srcVector, 24);
+            alphaChannel = _mm256_or_si256(alphaChannel, _mm256_slli_epi32(alphaChannel, 16));
+            alphaChannel = _mm256_sub_epi16(one, alphaChannel);
+
+            const __m256i dstVector = _mm256_loadu_si256((const __m256i *)&dst[x]);
+            __m256i destMultipliedByOneMinusAlpha;
+            BYTE_MUL_AVX2(destMultipliedByOneMinusAlpha, dstVector, alphaChannel, colorMask, half);
+
+            const __m256i result = _mm256_add_epi8(srcVector, destMultipliedByOneMinusAlpha);
+            _mm256_storeu_si256((__m256i *)&dst[x], result);
+        }
+    }
+    for (; x < length; ++x)
+        blend_pixel(dst[x], src[x]);
+}
+
+// dest = s * ca + d * (1 - sa * ca), const_alpha being in [0, 255]
+static void blend_source_over_argb32_with_const_alpha_avx2(quint32 *dst, const quint32 *src, int length, int const_alpha)
+{
+    const __m256i half = _mm256_set1_epi16(0x80);
+    const __m256i one = _mm256_set1_epi16(0xff);
+    const __m256i colorMask = _mm256_set1_epi32(0x00ff00ff);
+    const __m256i constAlphaVector = _mm256_set1_epi16(const_alpha);
+
+    int x = 0;
+    for (; x < length - 7; x += 8) {
+        __m256i srcVector = _mm256_loadu_si256((const __m256i *)&src[x]);
+        if (!_mm256_testz_si256(srcVector, srcVector)) {
+            BYTE_MUL_AVX2(srcVector, srcVector, constAlphaVector, colorMask, half);
+
+            __m256i alphaChannel = _mm256_srli_epi32(srcVector, 24);
+            alphaChannel = _mm256_or_si256(alphaChannel, _mm256_slli_epi32(alphaChannel, 16));
+            alphaChannel = _mm256_sub_epi16(one, alphaChannel);
+
+            const __m256i dstVector = _mm256_loadu_si256((const __m256i *)&dst[x]);
+            __m256i destMultipliedByOneMinusAlpha;
+            BYTE_MUL_AVX2(destMultipliedByOneMinusAlpha, dstVector, alphaChannel, colorMask, half);
+
+            const __m256i result = _mm256_add_epi8(srcVector, destMultipliedByOneMinusAlpha);
+            _mm256_storeu_si256((__m256i *)&dst[x], result);
+        }
+    }
+    for (; x < length; ++x)
+        blend_pixel(dst[x], src[x], const_alpha);
+}
+
+void qt_blend_argb32_on_argb32_avx2(uchar *destPixels, int dbpl,
+                                    const uchar *srcPixels, int sbpl,
+                                    int w, int h,
+                                    int const_alpha)
+{
+    const quint32 *src = (const quint32 *) srcPixels;
+    quint32 *dst = (quint32 *) destPixels;
+    if (const_alpha == 256) {
+        for (int y = 0; y < h; ++y) {
+            blend_source_over_argb32_avx2(dst, src, w);
+            dst = (quint32 *)(((uchar *) dst) + dbpl);
+            src = (const quint32 *)(((const uchar *) src) + sbpl);
+        }
+    } else if (const_alpha != 0) {
+        const_alpha = (const_alpha * 255) >> 8;
+        for (int y = 0; y < h; ++y) {
+            blend_source_over_argb32_with_const_alpha_avx2(dst, src, w, const_alpha);
+            dst = (quint32 *)(((uchar *) dst) + dbpl);
+            src = (const quint32 *)(((const uchar *) src) + sbpl);
+        }
+    }
+}
+
+void QT_FASTCALL comp_func_SourceOver_avx2(uint *destPixels, const uint *srcPixels, int length, uint const_alpha)
+{
+    Q_ASSERT(const_alpha < 256);
+
+    if (const_alpha == 255)
+        blend_source_over_argb32_avx2(destPixels, srcPixels, length);
+    else
+        blend_source_over_argb32_with_const_alpha_avx2(destPixels, srcPixels, length, const_alpha);
+}
+
+/*
+ * First pass of the bilinear upscaling in fetchTransformedBilinear(): interpolates
+ * count pixels of the rows s1 and s2, disty being the weight of s2 in [0, 256].
+ * The red-blue components go to rb (0x00RR00BB) and the alpha-green ones to ag
+ * (0x00AA00GG). count must be a multiple of 8.
+ */
+void QT_FASTCALL qt_bilinear_interpolate_rows_avx2(quint32 *rb, quint32 *ag,
+                                                   const uint *s1, const uint *s2,
+                                                   int count, int disty)
+{
+    const __m256i disty_ = _mm256_set1_epi16(disty);
+    const __m256i idisty_ = _mm256_set1_epi16(256 - disty);
+    const __m256i colorMask = _mm256_set1_epi32(0x00ff00ff);
+
+    for (int x = 0; x < count; x += 8) {
+        const __m256i top = _mm256_loadu_si256((const __m256i *)(s1 + x));
+        const __m256i topAG = _mm256_mullo_epi16(_mm256_srli_epi16(top, 8), idisty_);
+        const __m256i topRB = _mm256_mullo_epi16(_mm256_and_si256(top, colorMask), idisty_);
+
+        const __m256i bottom = _mm256_loadu_si256((const __m256i *)(s2 + x));
+        const __m256i bottomAG = _mm256_mullo_epi16(_mm256_srli_epi16(bottom, 8), disty_);
+        const __m256i bottomRB = _mm256_mullo_epi16(_mm256_and_si256(bottom, colorMask), disty_);
+
+        _mm256_storeu_si256((__m256i *)(ag + x), _mm256_srli_epi16(_mm256_add_epi16(topAG, bottomAG), 8));
+        _mm256_storeu_si256((__m256i *)(rb + x), _mm256_srli_epi16(_mm256_add_epi16(topRB, bottomRB), 8));
+    }
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_HAVE_AVX2
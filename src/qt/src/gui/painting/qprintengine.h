@@ -92,6 +92,7 @@ public:
         PPK_UseCompression,
         PPK_ImageQuality, 
         PPK_ImageDPI,
+        PPK_ImageCompression,
         PPK_PaperSize = PPK_PageSize,
         PPK_CustomBase = 0xff00
     };
@@ -50,6 +50,7 @@
 #include <qdebug.h>
 #include <qimagewriter.h>
 #include <qbuffer.h>
+#include <qset.h>
 #include <qdatetime.h>
 #include <QCryptographicHash>
 
@@ -112,6 +113,15 @@ void QPdfEngine::setProperty(PrintEnginePropertyKey key, const QVariant &value)
 		d->imageQuality = value.toInt();
 	else if (key==PPK_ImageDPI)
 		d->imageDPI = value.toInt();
+    else if (key==PPK_ImageCompression) {
+        const QString compression = value.toString();
+        if (compression == QLatin1String("lossless"))
+            d->imageCompression = QPdfEnginePrivate::LosslessImageCompression;
+        else if (compression == QLatin1String("jpeg"))
+            d->imageCompression = QPdfEnginePrivate::JpegImageCompression;
+        else
+            d->imageCompression = QPdfEnginePrivate::AutoImageCompression;
+    }
     else 
         QPdfBaseEngine::setProperty(key, value);
 }
@@ -124,6 +134,13 @@ QVariant QPdfEngine::property(PrintEnginePropertyKey key) const {
 		return d->imageQuality;
 	else if (key==PPK_ImageDPI)
         return d->imageDPI;
+    else if (key==PPK_ImageCompression) {
+        switch (d->imageCompression) {
+        case QPdfEnginePrivate::LosslessImageCompression: return QLatin1String("lossless");
+        case QPdfEnginePrivate::JpegImageCompression: return QLatin1String("jpeg");
+        default: return QLatin1String("auto");
+        }
+    }
     else
         return QPdfBaseEngine::property(key);
 }
@@ -163,6 +180,7 @@ bool QPdfEngine::begin(QPaintDevice *pdev)
 
     d->pages.clear();
     d->imageCache.clear();
+    d->imageContentCache.clear();
 
     setActive(true);
     state = QPrinter::Active;
@@ -456,6 +474,7 @@ QPdfEnginePrivate::QPdfEnginePrivate(QPrinter::PrinterMode m)
     doCompress = true;
     imageDPI = 1400;
     imageQuality = 94;
+    imageCompression = AutoImageCompression;
 
     stream = new QDataStream;
     pageOrder = QPrinter::FirstPageFirst;
@@ -745,6 +764,138 @@ void QPdfEnginePrivate::convertImage(const QImage & image, QByteArray & imageDat
     }
 }
 
+static void hashImage(QCryptographicHash &hash, const QImage &image)
+{
+    const int header[] = { image.width(), image.height(), image.format() };
+    hash.addData(reinterpret_cast<const char *>(header), sizeof(header));
+    const QVector<QRgb> colorTable = image.colorTable();
+    hash.addData(reinterpret_cast<const char *>(colorTable.constData()), colorTable.size() * sizeof(QRgb));
+    // Only the pixels, scan lines may be padded with garbage
+    const int bytesPerLine = (image.width() * image.depth() + 7) >> 3;
+    for (int y = 0; y < image.height(); ++y)
+        hash.addData(reinterpret_cast<const char *>(image.constScanLine(y)), bytesPerLine);
+}
+
+static QByteArray imageContentKey(const QImage &image, bool bitmap, const QImage *noneScaled, const QByteArray *data)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(bitmap ? "b" : "i", 1);
+    if (noneScaled && data) {
+        // The downloaded bytes identify the pixels, which is cheaper than
+        // hashing them; the image may still have been scaled down
+        const int size[] = { image.width(), image.height() };
+        hash.addData(reinterpret_cast<const char *>(size), sizeof(size));
+        hash.addData(*data);
+    } else {
+        hashImage(hash, image);
+    }
+    return hash.result();
+}
+
+/*
+ * Returns the number of colour components of a baseline or progressive
+ * JPEG image, or 0 if \a data is not one.
+ */
+static int jpegComponents(const QByteArray &data)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(data.constData());
+    const int size = data.size();
+    if (size < 4 || p[0] != 0xff || p[1] != 0xd8)
+        return 0;
+    int pos = 2;
+    while (pos + 4 <= size) {
+        if (p[pos] != 0xff)
+            return 0;
+        const uchar marker = p[pos + 1];
+        if (marker == 0xff) {   // fill byte
+            ++pos;
+            continue;
+        }
+        const int length = (p[pos + 2] << 8) | p[pos + 3];
+        if (marker >= 0xc0 && marker <= 0xcf && marker != 0xc4 && marker != 0xc8 && marker != 0xcc)
+            return pos + 9 < size ? p[pos + 9] : 0;
+        if (marker == 0xda || marker == 0xd9)  // image data before any frame header
+            return 0;
+        pos += 2 + length;
+    }
+    return 0;
+}
+
+static inline quint32 pngUInt32(const uchar *p)
+{
+    return (quint32(p[0]) << 24) | (quint32(p[1]) << 16) | (quint32(p[2]) << 8) | quint32(p[3]);
+}
+
+/*
+ * Extracts the zlib stream of a non-interlaced, 8 bit, opaque grayscale or
+ * RGB PNG image of the given size, which PDF can read as is through the
+ * PNG predictors of FlateDecode. Returns the number of colour components,
+ * or 0 if the image has to be encoded again.
+ */
+static int pngImageData(const QByteArray &data, int width, int height, QByteArray *imageData)
+{
+    static const uchar signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    const uchar *p = reinterpret_cast<const uchar *>(data.constData());
+    const int size = data.size();
+    if (size < 8 + 25 || memcmp(p, signature, sizeof(signature)) != 0)
+        return 0;
+
+    int colors = 0;
+    QByteArray idat;
+    int pos = 8;
+    while (pos + 12 <= size) {
+        const quint32 length = pngUInt32(p + pos);
+        const uchar *type = p + pos + 4;
+        const uchar *chunk = p + pos + 8;
+        if (length > quint32(size - pos - 12))
+            return 0;
+        if (memcmp(type, "IHDR", 4) == 0) {
+            if (length < 13 || int(pngUInt32(chunk)) != width || int(pngUInt32(chunk + 4)) != height)
+                return 0;
+            const uchar bitDepth = chunk[8];
+            const uchar colorType = chunk[9];
+            const uchar interlace = chunk[12];
+            if (bitDepth != 8 || interlace != 0 || (colorType != 0 && colorType != 2))
+                return 0;
+            colors = colorType == 2 ? 3 : 1;
+        } else if (memcmp(type, "tRNS", 4) == 0) {
+            return 0;
+        } else if (memcmp(type, "IDAT", 4) == 0) {
+            idat.append(reinterpret_cast<const char *>(chunk), length);
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        pos += 12 + length;
+    }
+    if (!colors || idat.isEmpty())
+        return 0;
+    *imageData = idat;
+    return colors;
+}
+
+/*
+ * Guesses from a sample of its pixels whether an image is a photograph,
+ * which compresses far better as JPEG, rather than a drawing or text
+ * which JPEG would blur.
+ */
+static bool isPhotographic(const QImage &image)
+{
+    const int maxColors = 256;
+    const int samples = 64;
+    const int stepX = qMax(1, image.width() / samples);
+    const int stepY = qMax(1, image.height() / samples);
+    QSet<QRgb> colors;
+    for (int y = 0; y < image.height(); y += stepY) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); x += stepX) {
+            colors.insert(line[x]);
+            if (colors.size() >= maxColors)
+                return true;
+        }
+    }
+    return false;
+}
+
 /*!
  * Adds an image to the pdf and return the pdf-object id. Returns -1 if adding the image failed.
  */
@@ -753,9 +904,31 @@ int QPdfEnginePrivate::addImage(const QImage &img, bool *bitmap, qint64 serial_n
     if (img.isNull())
         return -1;
 
-    int object = imageCache.value(serial_no);
-    if(object)
-        return object;
+    // Images are only ever embedded once. Painting the same image again is
+    // caught by its serial number; copies of it, like the same logo on
+    // every page of a document, by a hash of the content.
+    const QPair<qint64, qint64> serialKey(serial_no, (qint64(img.width()) << 32) | img.height());
+    ImageCacheEntry entry = imageCache.value(serialKey);
+    if (!entry.object) {
+        const QByteArray contentKey = imageContentKey(img, *bitmap, noneScaled, data);
+        entry = imageContentCache.value(contentKey);
+        if (!entry.object) {
+            entry.bitmap = *bitmap;
+            entry.object = embedImage(img, &entry.bitmap, noneScaled, data);
+            imageContentCache.insert(contentKey, entry);
+        }
+        imageCache.insert(serialKey, entry);
+    }
+
+    *bitmap = entry.bitmap;
+    if (useScaled)
+        *useScaled = true;
+    return entry.object;
+}
+
+int QPdfEnginePrivate::embedImage(const QImage &img, bool *bitmap, const QImage *noneScaled, const QByteArray *data)
+{
+    int object;
 
     QImage image = img;
     QImage::Format format = image.format();
@@ -789,72 +962,39 @@ int QPdfEnginePrivate::addImage(const QImage &img, bool *bitmap, qint64 serial_n
         }
         object = writeImage(data, w, h, d, 0, 0);
     } else {
+        // Images painted at their own size can be embedded exactly as they
+        // were downloaded, without encoding them at all
+        const bool passthrough = noneScaled && data && noneScaled->rect() == image.rect()
+            && colorMode != QPrinter::GrayScale;
         QByteArray imageData;
-        uLongf target=1024*1024*1024;
-        bool uns=false;
+        int depth = colorMode == QPrinter::GrayScale ? 8 : 32;
         bool dct = false;
-        if (QImageWriter::supportedImageFormats().contains("jpeg") && colorMode != QPrinter::GrayScale) {
-            QByteArray imageData2;
-            
-            QBuffer buffer(&imageData2);
-            QImageWriter writer(&buffer, "jpeg");
-            writer.setQuality(imageQuality);
-            writer.write(image);
-            
-            if ((uLongf)imageData2.size() < target) {
-                imageData=imageData2;
-                target = imageData2.size();
-                dct = true;
-                uns=false;
+        int pngColors = 0;
+        int components = 0;
+        if (passthrough && imageCompression != LosslessImageCompression
+            && ((components = jpegComponents(*data)) == 3 || components == 1)) {
+            imageData = *data;
+            depth = components == 3 ? 32 : 8;
+            dct = true;
+        } else if (passthrough && (pngColors = pngImageData(*data, w, h, &imageData)) != 0) {
+            depth = pngColors == 3 ? 32 : 8;
+        } else {
+            // Encode once, with the codec the policy picks
+            if (imageCompression != LosslessImageCompression && colorMode != QPrinter::GrayScale
+                && QImageWriter::supportedImageFormats().contains("jpeg"))
+                dct = imageCompression == JpegImageCompression || isPhotographic(image);
+            if (dct) {
+                QBuffer buffer(&imageData);
+                QImageWriter writer(&buffer, "jpeg");
+                writer.setQuality(imageQuality);
+                dct = writer.write(image);
             }
-        }
-
-        if (noneScaled && noneScaled->rect() != image.rect()) {
-            QByteArray imageData2;
-            convertImage(*noneScaled, imageData2);
-            uLongf len = imageData2.size();
-            uLongf destLen = len + len/100 + 13; // zlib requirement
-            Bytef* dest = new Bytef[destLen];
-            if (Z_OK == ::compress(dest, &destLen, (const Bytef*) imageData2.data(), (uLongf)len) &&
-                (uLongf)destLen < target) {
-                imageData=imageData2;
-                target=destLen;
-                dct=false;
-                uns=true;
+            if (!dct) {
+                imageData.clear();
+                convertImage(image, imageData);
             }
-            delete[] dest;
-        }
-        
-        {
-            QByteArray imageData2;
-            convertImage(image, imageData2);
-            uLongf len = imageData2.size();
-            uLongf destLen = len + len/100 + 13; // zlib requirement
-            Bytef* dest = new Bytef[destLen];
-            if (Z_OK == ::compress(dest, &destLen, (const Bytef*) imageData2.data(), (uLongf)len) &&
-                (uLongf)destLen < target) {
-                imageData=imageData2;
-                target=destLen;
-                dct=false;
-                uns=false;
-            }
-            delete[] dest;
-        }
-
-        if (colorMode != QPrinter::GrayScale && noneScaled != 0 && data != 0 &&
-            data->size() > 2 && (unsigned char)data->data()[0] == 0xff && (unsigned char)data->data()[1] == 0xd8 &&
-            (uLongf)data->size()*10 < target*13) {
-            imageData = *data;
-            target=data->size();
-            dct=true;
-            uns=true;
         }
 
-        if (uns) {
-            w = noneScaled->width();
-            h = noneScaled->height();
-        }
-        if (useScaled) *useScaled = (uns?false:true);
         QByteArray softMaskData;
         bool hasAlpha = false;
         bool hasMask = false;
@@ -863,7 +1003,7 @@ int QPdfEnginePrivate::addImage(const QImage &img, bool *bitmap, qint64 serial_n
             softMaskData.resize(w * h);
             uchar *sdata = (uchar *)softMaskData.data();
             for (int y = 0; y < h; ++y) {
-                const QRgb *rgb = (const QRgb *)(uns?noneScaled->scanLine(y):image.scanLine(y));
+                const QRgb *rgb = (const QRgb *)image.constScanLine(y);
                 for (int x = 0; x < w; ++x) {
                     uchar alpha = qAlpha(*rgb);
                     *sdata++ = alpha;
@@ -895,10 +1035,8 @@ int QPdfEnginePrivate::addImage(const QImage &img, bool *bitmap, qint64 serial_n
             }
             maskObject = writeImage(mask, w, h, 1, 0, 0);
         }
-        object = writeImage(imageData, w, h, colorMode == QPrinter::GrayScale ? 8 : 32,
-                            maskObject, softMaskObject, dct);
+        object = writeImage(imageData, w, h, depth, maskObject, softMaskObject, dct, pngColors);
     }
-    imageCache.insert(serial_no, object);
     return object;
 }
 
@@ -1100,7 +1238,7 @@ int QPdfEnginePrivate::writeCompressed(const char *src, int len)
 }
 
 int QPdfEnginePrivate::writeImage(const QByteArray &data, int width, int height, int depth,
-                                  int maskObject, int softMaskObject, bool dct)
+                                  int maskObject, int softMaskObject, bool dct, int pngColors)
 {
     int image = addXrefEntry(-1);
     xprintf("<<\n"
@@ -1131,6 +1269,13 @@ int QPdfEnginePrivate::writeImage(const QByteArray &data, int width, int height,
         xprintf("/Filter /DCTDecode\n>>\nstream\n");
         write(data);
         len = data.length();
+    } else if (pngColors) {
+        // Already deflated, with a PNG filter type in front of every row
+        xprintf("/Filter /FlateDecode\n"
+                "/DecodeParms << /Predictor 15 /Colors %d /BitsPerComponent 8 /Columns %d >>\n"
+                ">>\nstream\n", pngColors, width);
+        write(data);
+        len = data.length();
     } else {
         if (doCompress)
             xprintf("/Filter /FlateDecode\n>>\nstream\n");
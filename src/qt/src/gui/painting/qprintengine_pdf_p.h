@@ -190,6 +190,7 @@ public:
     void convertImage(const QImage & image, QByteArray & imageData);
 
     int addImage(const QImage &image, bool *bitmap, qint64 serial_no, const QImage * noneScaled=0, const QByteArray * data=0, bool * useScaled=0);
+    int embedImage(const QImage &image, bool *bitmap, const QImage *noneScaled, const QByteArray *data);
     int addConstantAlphaObject(int brushAlpha, int penAlpha = 255);
     int addBrushPattern(const QTransform &matrix, bool *specifyColor, int *gStateObject);
 
@@ -218,8 +219,16 @@ private:
     int imageDPI;
     int imageQuality;
 
+    // How images that are not embedded as downloaded get encoded
+    enum ImageCompression {
+        AutoImageCompression,       // JPEG for photographs, lossless for everything else
+        LosslessImageCompression,
+        JpegImageCompression
+    };
+    ImageCompression imageCompression;
+
     int writeImage(const QByteArray &data, int width, int height, int depth,
-                   int maskObject, int softMaskObject, bool dct = false);
+                   int maskObject, int softMaskObject, bool dct = false, int pngColors = 0);
     void writePage();
 
     int addXrefEntry(int object, bool printostr = true);
@@ -242,7 +251,13 @@ private:
     QVector<uint> dests;
     QHash<QString, uint> anchors;
     QVector<uint> pages;
-    QHash<qint64, uint> imageCache;
+    struct ImageCacheEntry {
+        ImageCacheEntry() : object(0), bitmap(false) {}
+        int object;
+        bool bitmap;
+    };
+    QHash<QPair<qint64, qint64>, ImageCacheEntry> imageCache;
+    QHash<QByteArray, ImageCacheEntry> imageContentCache;
     QHash<QPair<uint, uint>, uint > alphaCache;
 };
 
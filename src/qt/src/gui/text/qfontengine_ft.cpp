@@ -47,6 +47,7 @@
 
 #ifndef QT_NO_FREETYPE
 
+#include "qcache.h"
 #include "qfile.h"
 #include "qabstractfileengine.h"
 #include "qthreadstorage.h"
@@ -545,6 +546,155 @@ QFontEngineFT::Glyph::~Glyph()
     delete [] data;
 }
 
+/*
+ * Process wide cache of rendered glyphs.
+ *
+ * Every QFontEngineFT keeps the glyphs it renders in its own glyph sets,
+ * which go away with the engine once QFontCache expires it. Glyphs are
+ * also kept here, keyed by everything that affects the rendered bitmap,
+ * so that engines for the same face and size (e.g. created again for a
+ * later page or render) can copy them instead of rasterizing them again.
+ */
+struct QFtSharedGlyphKey
+{
+    QFontEngine::FaceId faceId;
+    int xsize;
+    int ysize;
+    FT_Matrix matrix;
+    glyph_t glyph;
+    int subPixelPosition;
+    int format;
+    int loadFlags;
+    int renderFlags;
+};
+
+static inline bool operator==(const QFtSharedGlyphKey &a, const QFtSharedGlyphKey &b)
+{
+    return a.glyph == b.glyph && a.subPixelPosition == b.subPixelPosition
+        && a.xsize == b.xsize && a.ysize == b.ysize
+        && a.matrix.xx == b.matrix.xx && a.matrix.xy == b.matrix.xy
+        && a.matrix.yx == b.matrix.yx && a.matrix.yy == b.matrix.yy
+        && a.format == b.format && a.loadFlags == b.loadFlags && a.renderFlags == b.renderFlags
+        && a.faceId.index == b.faceId.index && a.faceId.encoding == b.faceId.encoding
+        && a.faceId.filename == b.faceId.filename && a.faceId.uuid == b.faceId.uuid;
+}
+
+static inline uint qHash(const QFtSharedGlyphKey &k)
+{
+    return qHash(k.faceId) ^ (k.glyph << 8) ^ (k.ysize << 20) ^ k.xsize
+        ^ (k.subPixelPosition << 4) ^ uint(k.loadFlags) ^ (k.format << 28);
+}
+
+static int qt_ft_glyph_data_size(const QFontEngineFT::Glyph *g)
+{
+    const int pitch = (g->format == QFontEngineFT::Format_Mono ? ((g->width + 31) & ~31) >> 3 :
+                       (g->format == QFontEngineFT::Format_A8 ? (g->width + 3) & ~3 : g->width * 4));
+    return pitch * g->height;
+}
+
+// Copies the metrics and bitmap of src into dst, replacing dst's bitmap
+static void qt_ft_copy_glyph(QFontEngineFT::Glyph *dst, const QFontEngineFT::Glyph *src)
+{
+    dst->linearAdvance = src->linearAdvance;
+    dst->width = src->width;
+    dst->height = src->height;
+    dst->x = src->x;
+    dst->y = src->y;
+    dst->advance = src->advance;
+    dst->format = src->format;
+    delete [] dst->data;
+    dst->data = 0;
+    const int size = qt_ft_glyph_data_size(src);
+    if (src->data && size > 0) {
+        dst->data = new uchar[size];
+        memcpy(dst->data, src->data, size);
+    }
+}
+
+// Only rasterization is shared: the cached alpha maps are still blitted by
+// the existing raster engine drawhelpers. A SIMD alpha map blit is out of
+// scope here.
+class QFtSharedGlyphCache
+{
+public:
+    QFtSharedGlyphCache() : glyphs(4 * 1024 * 1024), hits(0), misses(0) {
+        const QByteArray env = qgetenv("QT_FT_GLYPH_CACHE_SIZE");
+        if (!env.isEmpty())
+            glyphs.setMaxCost(qMax(0, env.toInt()) * 1024);
+    }
+
+    bool isEnabled() const { return glyphs.maxCost() > 0; }
+
+    bool find(const QFtSharedGlyphKey &key, QFontEngineFT::Glyph *dst)
+    {
+        QMutexLocker locker(&mutex);
+        const QFontEngineFT::Glyph *g = glyphs.object(key);
+        if (!g) {
+            ++misses;
+            return false;
+        }
+        ++hits;
+        qt_ft_copy_glyph(dst, g);
+        return true;
+    }
+
+    void insert(const QFtSharedGlyphKey &key, const QFontEngineFT::Glyph *src)
+    {
+        QFontEngineFT::Glyph *g = new QFontEngineFT::Glyph;
+        g->data = 0;
+        g->uploadedToServer = false;
+        qt_ft_copy_glyph(g, src);
+
+        QMutexLocker locker(&mutex);
+        glyphs.insert(key, g, sizeof(QFontEngineFT::Glyph) + qt_ft_glyph_data_size(g));
+    }
+
+    void setMaxCost(int bytes)
+    {
+        QMutexLocker locker(&mutex);
+        glyphs.setMaxCost(qMax(0, bytes));
+    }
+
+    QVariantMap statistics()
+    {
+        QMutexLocker locker(&mutex);
+        QVariantMap result;
+        result["count"] = glyphs.count();
+        result["size"] = glyphs.totalCost();
+        result["capacity"] = glyphs.maxCost();
+        result["hits"] = hits;
+        result["misses"] = misses;
+        return result;
+    }
+
+private:
+    QMutex mutex;
+    QCache<QFtSharedGlyphKey, QFontEngineFT::Glyph> glyphs;
+    int hits;
+    int misses;
+};
+
+Q_GLOBAL_STATIC(QFtSharedGlyphCache, qt_ft_shared_glyph_cache)
+
+/*
+    Sets the memory budget of the glyph cache shared by all the FreeType
+    font engines to \a kilobytes; 0 disables it. Can also be set with the
+    QT_FT_GLYPH_CACHE_SIZE environment variable. The default is 4 MB.
+*/
+Q_GUI_EXPORT void qt_ft_set_glyph_cache_size(int kilobytes)
+{
+    qt_ft_shared_glyph_cache()->setMaxCost(kilobytes * 1024);
+}
+
+/*
+    Returns the usage of the shared glyph cache: "count", "size" and
+    "capacity" (in bytes), "hits" and "misses".
+*/
+Q_GUI_EXPORT QVariantMap qt_ft_glyph_cache_statistics()
+{
+    return qt_ft_shared_glyph_cache()->statistics();
+}
+
 static const uint subpixel_filter[3][3] = {
     { 180, 60, 16 },
     { 38, 180, 38 },
@@ -859,6 +1009,37 @@ QFontEngineFT::Glyph *QFontEngineFT::loadGlyph(QGlyphSet *set, uint glyph,
     if (transform)
         load_flags |= FT_LOAD_NO_BITMAP;
 
+    // Anonymous faces can't be told apart, and outline and server side
+    // glyphs don't need a bitmap to be kept around
+    QFtSharedGlyphCache *sharedCache = qt_ft_shared_glyph_cache();
+    const bool useSharedCache = sharedCache && sharedCache->isEnabled()
+                                && !uploadToServer && !set->outline_drawing
+                                && (!face_id.filename.isEmpty() || !face_id.uuid.isEmpty());
+    QFtSharedGlyphKey sharedKey;
+    if (useSharedCache) {
+        sharedKey.faceId = face_id;
+        sharedKey.xsize = xsize;
+        sharedKey.ysize = ysize;
+        sharedKey.matrix = matrix;
+        sharedKey.glyph = glyph;
+        sharedKey.subPixelPosition = format == Format_Mono ? 0 : subPixelPosition.value();
+        sharedKey.format = format;
+        sharedKey.loadFlags = load_flags;
+        sharedKey.renderFlags = int(embolden) | (subpixelType << 1) | (lcdFilterType << 4);
+
+        Glyph *shared = g ? g : new Glyph;
+        if (!g) {
+            shared->uploadedToServer = false;
+            shared->data = 0;
+        }
+        if (sharedCache->find(sharedKey, shared)) {
+            set->setGlyph(glyph, subPixelPosition, shared);
+            return shared;
+        }
+        if (!g)
+            delete shared;
+    }
+
     FT_Face face = freetype->face;
 
     FT_Vector v;
@@ -1114,6 +1295,9 @@ QFontEngineFT::Glyph *QFontEngineFT::loadGlyph(QGlyphSet *set, uint glyph,
 
     set->setGlyph(glyph, subPixelPosition, g);
 
+    if (useSharedCache)
+        sharedCache->insert(sharedKey, g);
+
     return g;
 }
 
@@ -6,6 +6,7 @@ HEADERS += \
     access/qhttpnetworkheader_p.h \
     access/qhttpnetworkrequest_p.h \
     access/qhttpnetworkreply_p.h \
+    access/qnetworktimestamp_p.h \
     access/qhttpnetworkconnection_p.h \
     access/qhttpnetworkconnectionchannel_p.h \
     access/qnetworkaccessauthenticationmanager_p.h \
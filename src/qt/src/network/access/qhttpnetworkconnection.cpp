@@ -69,13 +69,13 @@
 QT_BEGIN_NAMESPACE
 
 #ifdef Q_OS_SYMBIAN
-const int QHttpNetworkConnectionPrivate::defaultChannelCount = 3;
+int QHttpNetworkConnectionPrivate::defaultChannelCount = 3;
 #else
-const int QHttpNetworkConnectionPrivate::defaultChannelCount = 6;
+int QHttpNetworkConnectionPrivate::defaultChannelCount = 6;
 #endif
 
 // The pipeline length. So there will be 4 requests in flight.
-const int QHttpNetworkConnectionPrivate::defaultPipelineLength = 3;
+int QHttpNetworkConnectionPrivate::defaultPipelineLength = 3;
 // Only re-fill the pipeline if there's defaultRePipelineLength slots free in the pipeline.
 // This means that there are 2 requests in flight and 2 slots free that will be re-filled.
 const int QHttpNetworkConnectionPrivate::defaultRePipelineLength = 2;
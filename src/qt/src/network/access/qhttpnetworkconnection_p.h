@@ -143,8 +143,10 @@ class QHttpNetworkConnectionPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QHttpNetworkConnection)
 public:
-    static const int defaultChannelCount;
-    static const int defaultPipelineLength;
+    // Not const: QNetworkAccessManager::setHttpConnectionsPerHost() and
+    // setHttpPipelineLength() change them for connections created afterwards.
+    static int defaultChannelCount;
+    static int defaultPipelineLength;
     static const int defaultRePipelineLength;
 
     enum ConnectionState {
@@ -110,6 +110,9 @@ void QHttpNetworkConnectionChannel::init()
     QObject::connect(socket, SIGNAL(bytesWritten(qint64)),
                      this, SLOT(_q_bytesWritten(qint64)),
                      Qt::DirectConnection);
+    QObject::connect(socket, SIGNAL(hostFound()),
+                     this, SLOT(_q_hostFound()),
+                     Qt::DirectConnection);
     QObject::connect(socket, SIGNAL(connected()),
                      this, SLOT(_q_connected()),
                      Qt::DirectConnection);
@@ -193,6 +196,9 @@ bool QHttpNetworkConnectionChannel::sendRequest()
         replyPrivate->connectionChannel = this;
         replyPrivate->autoDecompress = request.d->autoDecompress;
         replyPrivate->pipeliningUsed = false;
+        replyPrivate->timings = connectTimings;
+        replyPrivate->timings.sendStart = qt_network_timestamp();
+        connectTimings.reset();
 
         // if the url contains authentication parameters, use the new ones
         // both channels will use the new authentication parameters
@@ -305,6 +311,9 @@ bool QHttpNetworkConnectionChannel::sendRequest()
 
     case QHttpNetworkConnectionChannel::WaitingState:
     {
+        if (reply->d_func()->timings.sendEnd < 0)
+            reply->d_func()->timings.sendEnd = qt_network_timestamp();
+
         QNonContiguousByteDevice* uploadByteDevice = request.uploadByteDevice();
         if (uploadByteDevice) {
             QObject::disconnect(uploadByteDevice, SIGNAL(readyRead()), this, SLOT(_q_uploadDataReadyRead()));
@@ -379,6 +388,7 @@ void QHttpNetworkConnectionChannel::_q_receiveReply()
         QHttpNetworkReplyPrivate::ReplyState state = reply->d_func()->state;
         switch (state) {
         case QHttpNetworkReplyPrivate::NothingDoneState: {
+            reply->d_func()->timings.responseStart = qt_network_timestamp();
             state = reply->d_func()->state = QHttpNetworkReplyPrivate::ReadingStatusState;
             // fallthrough
         }
@@ -555,6 +565,8 @@ bool QHttpNetworkConnectionChannel::ensureConnection()
         // connect to the host if not already connected.
         state = QHttpNetworkConnectionChannel::ConnectingState;
         pendingEncrypt = ssl;
+        connectTimings.reset();
+        connectTimings.dnsStart = qt_network_timestamp();
 
         // reset state
         pipeliningSupported = PipeliningSupportUnknown;
@@ -701,6 +713,7 @@ void QHttpNetworkConnectionChannel::allDone()
         qWarning() << "QHttpNetworkConnectionChannel::allDone() called without reply. Please report at http://bugreports.qt-project.org/";
         return;
     }
+    reply->d_func()->timings.responseEnd = qt_network_timestamp();
 
     // while handling 401 & 407, we might reset the status code, so save this.
     bool emitFinished = reply->d_func()->shouldEmitSignals();
@@ -893,6 +906,8 @@ void QHttpNetworkConnectionChannel::pipelineInto(HttpMessagePair &pair)
     reply->d_func()->connectionChannel = this;
     reply->d_func()->autoDecompress = request.d->autoDecompress;
     reply->d_func()->pipeliningUsed = true;
+    reply->d_func()->timings.reset();
+    reply->d_func()->timings.sendStart = reply->d_func()->timings.sendEnd = qt_network_timestamp();
 
 #ifndef QT_NO_NETWORKPROXY
     pipeline.append(QHttpNetworkRequestPrivate::header(request,
@@ -1011,6 +1026,11 @@ void QHttpNetworkConnectionChannel::_q_disconnected()
 }
 
 
+void QHttpNetworkConnectionChannel::_q_hostFound()
+{
+    connectTimings.dnsEnd = connectTimings.connectStart = qt_network_timestamp();
+}
+
 void QHttpNetworkConnectionChannel::_q_connected()
 {
     // improve performance since we get the request sent by the kernel ASAP
@@ -1025,6 +1045,10 @@ void QHttpNetworkConnectionChannel::_q_connected()
     // not sure yet if it helps, but it makes sense
     socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
 
+    connectTimings.connectEnd = qt_network_timestamp();
+    if (pendingEncrypt)
+        connectTimings.sslStart = connectTimings.connectEnd;
+
     pipeliningSupported = QHttpNetworkConnectionChannel::PipeliningSupportUnknown;
 
     // ### FIXME: if the server closes the connection unexpectedly, we shouldn't send the same broken request again!
@@ -1164,6 +1188,7 @@ void QHttpNetworkConnectionChannel::_q_encrypted()
         return; // ### error
     state = QHttpNetworkConnectionChannel::IdleState;
     pendingEncrypt = false;
+    connectTimings.sslEnd = qt_network_timestamp();
     if (!reply)
         connection->d_func()->dequeueRequest(socket);
     if (reply)
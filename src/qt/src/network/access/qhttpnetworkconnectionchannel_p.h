@@ -108,6 +108,7 @@ public:
     bool resendCurrent;
     int lastStatus; // last status received on this channel
     bool pendingEncrypt; // for https (send after encrypted)
+    QHttpNetworkTimings connectTimings; // of the connection being opened, for the first request sent on it
     int reconnectAttempts; // maximum 2 reconnection attempts
     QAuthenticatorPrivate::Method authMethod;
     QAuthenticatorPrivate::Method proxyAuthMethod;
@@ -170,6 +171,7 @@ public:
     void _q_bytesWritten(qint64 bytes); // proceed sending
     void _q_readyRead(); // pending data to read
     void _q_disconnected(); // disconnected from host
+    void _q_hostFound(); // host lookup done, connecting
     void _q_connected(); // start sending request
     void _q_error(QAbstractSocket::SocketError); // error from socket
 #ifndef QT_NO_NETWORKPROXY
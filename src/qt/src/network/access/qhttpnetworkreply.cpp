@@ -43,6 +43,7 @@
 #include "qhttpnetworkconnection_p.h"
 
 #include <qbytearraymatcher.h>
+#include <qelapsedtimer.h>
 
 #ifndef QT_NO_HTTP
 
@@ -54,6 +55,40 @@
 
 QT_BEGIN_NAMESPACE
 
+class QNetworkTimestampClock
+{
+public:
+    QNetworkTimestampClock() { timer.start(); }
+    QElapsedTimer timer;
+};
+Q_GLOBAL_STATIC(QNetworkTimestampClock, networkTimestampClock)
+
+qint64 qt_network_timestamp()
+{
+    return networkTimestampClock()->timer.nsecsElapsed();
+}
+
+static inline QVariant timestampToMilliseconds(qint64 timestamp)
+{
+    return timestamp < 0 ? -1.0 : timestamp / 1000000.0;
+}
+
+QVariantMap QHttpNetworkTimings::toVariantMap() const
+{
+    QVariantMap map;
+    map.insert(QLatin1String("dnsStart"), timestampToMilliseconds(dnsStart));
+    map.insert(QLatin1String("dnsEnd"), timestampToMilliseconds(dnsEnd));
+    map.insert(QLatin1String("connectStart"), timestampToMilliseconds(connectStart));
+    map.insert(QLatin1String("connectEnd"), timestampToMilliseconds(connectEnd));
+    map.insert(QLatin1String("sslStart"), timestampToMilliseconds(sslStart));
+    map.insert(QLatin1String("sslEnd"), timestampToMilliseconds(sslEnd));
+    map.insert(QLatin1String("sendStart"), timestampToMilliseconds(sendStart));
+    map.insert(QLatin1String("sendEnd"), timestampToMilliseconds(sendEnd));
+    map.insert(QLatin1String("responseStart"), timestampToMilliseconds(responseStart));
+    map.insert(QLatin1String("responseEnd"), timestampToMilliseconds(responseEnd));
+    return map;
+}
+
 QHttpNetworkReply::QHttpNetworkReply(const QUrl &url, QObject *parent)
     : QObject(*new QHttpNetworkReplyPrivate(url), parent)
 {
@@ -255,6 +290,11 @@ bool QHttpNetworkReply::isPipeliningUsed() const
     return d_func()->pipeliningUsed;
 }
 
+QVariantMap QHttpNetworkReply::timings() const
+{
+    return d_func()->timings.toVariantMap();
+}
+
 QHttpNetworkConnection* QHttpNetworkReply::connection()
 {
     return d_func()->connection;
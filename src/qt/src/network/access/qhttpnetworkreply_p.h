@@ -82,6 +82,7 @@ static const unsigned char gz_magic[2] = {0x1f, 0x8b}; // gzip magic header
 #include <private/qauthenticator_p.h>
 #include <private/qringbuffer_p.h>
 #include <private/qbytedata_p.h>
+#include <private/qnetworktimestamp_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -90,6 +91,35 @@ class QHttpNetworkConnectionChannel;
 class QHttpNetworkRequest;
 class QHttpNetworkConnectionPrivate;
 class QHttpNetworkReplyPrivate;
+
+// When each phase of a request started and ended, as qt_network_timestamp()
+// values. The phases that did not happen are -1, e.g. the lookup and the
+// connect of a request sent on a connection that was already open.
+struct QHttpNetworkTimings
+{
+    QHttpNetworkTimings() { reset(); }
+
+    void reset()
+    {
+        dnsStart = dnsEnd = connectStart = connectEnd = sslStart = sslEnd = -1;
+        sendStart = sendEnd = responseStart = responseEnd = -1;
+    }
+
+    // In milliseconds, as expected by QNetworkRequest::HttpTimingsAttribute
+    QVariantMap toVariantMap() const;
+
+    qint64 dnsStart;
+    qint64 dnsEnd;
+    qint64 connectStart;
+    qint64 connectEnd;
+    qint64 sslStart;
+    qint64 sslEnd;
+    qint64 sendStart;
+    qint64 sendEnd;
+    qint64 responseStart; // first byte of the response
+    qint64 responseEnd; // last byte of the response
+};
+
 class Q_AUTOTEST_EXPORT QHttpNetworkReply : public QObject, public QHttpNetworkHeader
 {
     Q_OBJECT
@@ -141,6 +171,8 @@ public:
 
     bool isPipeliningUsed() const;
 
+    QVariantMap timings() const;
+
     QHttpNetworkConnection* connection();
 
 #ifndef QT_NO_OPENSSL
@@ -256,6 +288,8 @@ public:
     bool pipeliningUsed;
     bool downstreamLimited;
 
+    QHttpNetworkTimings timings;
+
     char* userProvidedDownloadBuffer;
 };
 
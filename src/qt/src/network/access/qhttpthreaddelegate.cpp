@@ -436,6 +436,7 @@ void QHttpThreadDelegate::finishedSlot()
             emit error(statusCodeFromHttp(httpReply->statusCode(), httpRequest.url()), msg);
         }
 
+    emit downloadTimings(httpReply->timings());
     emit downloadFinished();
 
     QMetaObject::invokeMethod(httpReply, "deleteLater", Qt::QueuedConnection);
@@ -459,6 +460,7 @@ void QHttpThreadDelegate::synchronousFinishedSlot()
             incomingErrorCode = statusCodeFromHttp(httpReply->statusCode(), httpRequest.url());
     }
 
+    incomingTimings = httpReply->timings();
     synchronousDownloadData = httpReply->readAll();
 
     QMetaObject::invokeMethod(httpReply, "deleteLater", Qt::QueuedConnection);
@@ -479,6 +481,7 @@ void QHttpThreadDelegate::finishedWithErrorSlot(QNetworkReply::NetworkError erro
     if (ssl)
         emit sslConfigurationChanged(httpReply->sslConfiguration());
 #endif
+    emit downloadTimings(httpReply->timings());
     emit error(errorCode,detail);
     emit downloadFinished();
 
@@ -499,6 +502,7 @@ void QHttpThreadDelegate::synchronousFinishedWithErrorSlot(QNetworkReply::Networ
 #endif
     incomingErrorCode = errorCode;
     incomingErrorDetail = detail;
+    incomingTimings = httpReply->timings();
 
     QMetaObject::invokeMethod(httpReply, "deleteLater", Qt::QueuedConnection);
     QMetaObject::invokeMethod(synchronousRequestLoop, "quit", Qt::QueuedConnection);
@@ -541,6 +545,7 @@ void QHttpThreadDelegate::headerChangedSlot()
     isPipeliningUsed = httpReply->isPipeliningUsed();
     incomingContentLength = httpReply->contentLength();
 
+    emit downloadTimings(httpReply->timings());
     emit downloadMetaData(incomingHeaders,
                           incomingStatusCode,
                           incomingReasonPhrase,
@@ -112,6 +112,7 @@ public:
     QString incomingReasonPhrase;
     bool isPipeliningUsed;
     qint64 incomingContentLength;
+    QVariantMap incomingTimings;
     QNetworkReply::NetworkError incomingErrorCode;
     QString incomingErrorDetail;
 #ifndef QT_NO_BEARERMANAGEMENT
@@ -139,6 +140,7 @@ signals:
     void sslConfigurationChanged(const QSslConfiguration);
 #endif
     void downloadMetaData(QList<QPair<QByteArray,QByteArray> >,int,QString,bool,QSharedPointer<char>,qint64);
+    void downloadTimings(QVariantMap);
     void downloadProgress(qint64, qint64);
     void downloadData(QByteArray);
     void error(QNetworkReply::NetworkError, const QString);
@@ -369,9 +369,14 @@ void QNetworkAccessHttpBackend::postRequest()
     } else if (!manager->httpThread) {
         // We use the manager-global thread.
         // At some point we could switch to having multiple threads if it makes sense.
-        manager->httpThread = new QThread();
-        QObject::connect(manager->httpThread, SIGNAL(finished()), manager->httpThread, SLOT(deleteLater()));
-        manager->httpThread->start();
+        if (QNetworkAccessManagerPrivate::shareHttpConnections) {
+            // The connection cache lives in the thread, so all managers share it
+            manager->httpThread = QNetworkAccessManagerPrivate::sharedHttpThread();
+        } else {
+            manager->httpThread = new QThread();
+            QObject::connect(manager->httpThread, SIGNAL(finished()), manager->httpThread, SLOT(deleteLater()));
+            manager->httpThread->start();
+        }
 #ifndef QT_NO_NETWORKPROXY
         qRegisterMetaType<QNetworkProxy>("QNetworkProxy");
 #endif
@@ -572,6 +577,9 @@ void QNetworkAccessHttpBackend::postRequest()
         connect(delegate, SIGNAL(downloadProgress(qint64,qint64)),
                 this, SLOT(replyDownloadProgressSlot(qint64,qint64)),
                 Qt::QueuedConnection);
+        connect(delegate, SIGNAL(downloadTimings(QVariantMap)),
+                this, SLOT(replyDownloadTimings(QVariantMap)),
+                Qt::QueuedConnection);
         connect(delegate, SIGNAL(error(QNetworkReply::NetworkError,QString)),
                 this, SLOT(httpError(QNetworkReply::NetworkError, const QString)),
                 Qt::QueuedConnection);
@@ -649,6 +657,7 @@ void QNetworkAccessHttpBackend::postRequest()
     if (isSynchronous()) {
         emit startHttpRequestSynchronously(); // This one is BlockingQueuedConnection, so it will return when all work is done
 
+        replyDownloadTimings(delegate->incomingTimings);
         if (delegate->incomingErrorCode != QNetworkReply::NoError) {
             replyDownloadMetaData
                     (delegate->incomingHeaders,
@@ -857,6 +866,11 @@ void QNetworkAccessHttpBackend::replyDownloadMetaData
     metaDataChanged();
 }
 
+void QNetworkAccessHttpBackend::replyDownloadTimings(QVariantMap timings)
+{
+    setAttribute(QNetworkRequest::HttpTimingsAttribute, timings);
+}
+
 void QNetworkAccessHttpBackend::replyDownloadProgressSlot(qint64 received,  qint64 total)
 {
     // we can be sure here that there is a download buffer
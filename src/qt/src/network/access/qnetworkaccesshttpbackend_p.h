@@ -119,6 +119,7 @@ private slots:
     void replyFinished();
     void replyDownloadMetaData(QList<QPair<QByteArray,QByteArray> >,int,QString,bool,QSharedPointer<char>,qint64);
     void replyDownloadProgressSlot(qint64,qint64);
+    void replyDownloadTimings(QVariantMap);
     void httpAuthenticationRequired(const QHttpNetworkRequest &request, QAuthenticator *auth);
     void httpError(QNetworkReply::NetworkError error, const QString &errorString);
 #ifndef QT_NO_OPENSSL
@@ -66,6 +66,7 @@
 #include "QtNetwork/qnetworkconfigmanager.h"
 #include "QtNetwork/qhttpmultipart.h"
 #include "qhttpmultipart_p.h"
+#include "qhttpnetworkconnection_p.h"
 
 #include "qthread.h"
 
@@ -860,6 +861,99 @@ QSharedPointer<QNetworkSession> QNetworkAccessManagerPrivate::getNetworkSession(
 
 #endif // QT_NO_BEARERMANAGEMENT
 
+/*!
+    \since 4.8
+
+    Sets the maximum number of parallel connections to a single host (and
+    port) to \a count, which defaults to 6. Only affects connections
+    opened afterwards.
+
+    \sa httpConnectionsPerHost()
+*/
+void QNetworkAccessManager::setHttpConnectionsPerHost(int count)
+{
+#ifndef QT_NO_HTTP
+    if (count > 0)
+        QHttpNetworkConnectionPrivate::defaultChannelCount = count;
+#else
+    Q_UNUSED(count);
+#endif
+}
+
+/*!
+    \since 4.8
+
+    Returns the maximum number of parallel connections to a single host.
+*/
+int QNetworkAccessManager::httpConnectionsPerHost()
+{
+#ifndef QT_NO_HTTP
+    return QHttpNetworkConnectionPrivate::defaultChannelCount;
+#else
+    return 0;
+#endif
+}
+
+/*!
+    \since 4.8
+
+    Sets the number of requests sent ahead on a single connection to \a length
+    for requests that have QNetworkRequest::HttpPipeliningAllowedAttribute set.
+    The default is 3.
+
+    \sa httpPipelineLength()
+*/
+void QNetworkAccessManager::setHttpPipelineLength(int length)
+{
+#ifndef QT_NO_HTTP
+    if (length > 0)
+        QHttpNetworkConnectionPrivate::defaultPipelineLength = length;
+#else
+    Q_UNUSED(length);
+#endif
+}
+
+/*!
+    \since 4.8
+
+    Returns the number of requests sent ahead on a single pipelined connection.
+*/
+int QNetworkAccessManager::httpPipelineLength()
+{
+#ifndef QT_NO_HTTP
+    return QHttpNetworkConnectionPrivate::defaultPipelineLength;
+#else
+    return 0;
+#endif
+}
+
+/*!
+    \since 4.8
+
+    If \a shared is true, HTTP connections are handled by a single thread
+    common to all QNetworkAccessManager instances created afterwards, so
+    idle keep-alive connections opened by one manager get reused by the
+    others and outlive the manager that opened them.
+
+    By default every manager has its own connections.
+
+    \sa sharedHttpConnections()
+*/
+void QNetworkAccessManager::setSharedHttpConnections(bool shared)
+{
+    QNetworkAccessManagerPrivate::shareHttpConnections = shared;
+}
+
+/*!
+    \since 4.8
+
+    Returns true if HTTP connections are shared between managers.
+*/
+bool QNetworkAccessManager::sharedHttpConnections()
+{
+    return QNetworkAccessManagerPrivate::shareHttpConnections;
+}
+
 /*!
     \since 4.7
 
@@ -1158,12 +1252,37 @@ QList<QNetworkProxy> QNetworkAccessManagerPrivate::queryProxy(const QNetworkProx
 }
 #endif
 
+bool QNetworkAccessManagerPrivate::shareHttpConnections = false;
+QThread *QNetworkAccessManagerPrivate::sharedHttpThreadInstance = 0;
+
+static void sharedHttpThread_cleanup()
+{
+    QThread *thread = QNetworkAccessManagerPrivate::sharedHttpThreadInstance;
+    QNetworkAccessManagerPrivate::sharedHttpThreadInstance = 0;
+    if (thread) {
+        thread->quit();
+        thread->wait(5000);
+        delete thread;
+    }
+}
+
+QThread *QNetworkAccessManagerPrivate::sharedHttpThread()
+{
+    if (!sharedHttpThreadInstance) {
+        sharedHttpThreadInstance = new QThread();
+        sharedHttpThreadInstance->start();
+        qAddPostRoutine(sharedHttpThread_cleanup);
+    }
+    return sharedHttpThreadInstance;
+}
+
 void QNetworkAccessManagerPrivate::clearCache(QNetworkAccessManager *manager)
 {
     manager->d_func()->objectCache.clear();
     manager->d_func()->authenticationManager->clearCache();
 
-    if (manager->d_func()->httpThread) {
+    // The shared thread is not ours to stop; its idle connections expire on their own
+    if (manager->d_func()->httpThread && manager->d_func()->httpThread != sharedHttpThreadInstance) {
         // The thread will deleteLater() itself from its finished() signal
         manager->d_func()->httpThread->quit();
         manager->d_func()->httpThread->wait(5000);
@@ -1173,7 +1292,7 @@ void QNetworkAccessManagerPrivate::clearCache(QNetworkAccessManager *manager)
 
 QNetworkAccessManagerPrivate::~QNetworkAccessManagerPrivate()
 {
-    if (httpThread) {
+    if (httpThread && httpThread != sharedHttpThreadInstance) {
         // The thread will deleteLater() itself from its finished() signal
         httpThread->quit();
         httpThread->wait(5000);
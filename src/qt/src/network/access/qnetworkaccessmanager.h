@@ -135,6 +135,13 @@ public:
     NetworkAccessibility networkAccessible() const;
 #endif
 
+    static void setHttpConnectionsPerHost(int count);
+    static int httpConnectionsPerHost();
+    static void setHttpPipelineLength(int length);
+    static int httpPipelineLength();
+    static void setSharedHttpConnections(bool shared);
+    static bool sharedHttpConnections();
+
 Q_SIGNALS:
 #ifndef QT_NO_NETWORKPROXY
     void proxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
@@ -130,6 +130,10 @@ public:
 
     QThread *httpThread;
 
+    // One HTTP thread, and so one connection cache, for all managers
+    static bool shareHttpConnections;
+    static QThread *sharedHttpThread();
+    static QThread *sharedHttpThreadInstance;
 
 #ifndef QT_NO_NETWORKPROXY
     QNetworkProxy proxy;
@@ -228,6 +228,17 @@ QT_BEGIN_NAMESPACE
 
     \omitvalue SynchronousRequestAttribute
 
+    \value HttpTimingsAttribute
+        Replies only, type: QVariant::Map (no default)
+        When the phases of an HTTP request started and ended, in
+        milliseconds on a monotonic clock shared by the whole process:
+        \c dnsStart, \c dnsEnd, \c connectStart, \c connectEnd,
+        \c sslStart, \c sslEnd, \c sendStart, \c sendEnd,
+        \c responseStart (first byte) and \c responseEnd (last byte).
+        Phases that did not happen, such as the connect of a request sent
+        on a connection that was already open, are -1. Set once the
+        headers are received and updated when the reply finishes.
+
     \value User
         Special type. Additional information can be passed in
         QVariants with types ranging from User to UserMax. The default
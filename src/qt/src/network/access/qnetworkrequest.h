@@ -86,6 +86,7 @@ public:
         MaximumDownloadBufferSizeAttribute, // internal
         DownloadBufferAttribute, // internal
         SynchronousRequestAttribute, // internal
+        HttpTimingsAttribute,
 
         User = 1000,
         UserMax = 32767
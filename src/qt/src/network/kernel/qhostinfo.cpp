@@ -43,6 +43,9 @@
 #include "qhostinfo_p.h"
 
 #include "QtCore/qscopedpointer.h"
+#include "QtCore/qdatastream.h"
+#include "QtCore/qdatetime.h"
+#include "QtCore/qfile.h"
 #include <qabstracteventdispatcher.h>
 #include <qcoreapplication.h>
 #include <qmetaobject.h>
@@ -741,6 +744,32 @@ void Q_AUTOTEST_EXPORT qt_qhostinfo_enable_cache(bool e)
     }
 }
 
+void qt_qhostinfo_set_cache_limits(int maxEntries, int maxAge)
+{
+    QAbstractHostInfoLookupManager* manager = theHostInfoLookupManager();
+    if (manager) {
+        manager->cache.setLimits(maxEntries, maxAge);
+    }
+}
+
+bool qt_qhostinfo_save_cache(const QString &fileName)
+{
+    QAbstractHostInfoLookupManager* manager = theHostInfoLookupManager();
+    QFile file(fileName);
+    if (!manager || !file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return manager->cache.save(&file);
+}
+
+bool qt_qhostinfo_load_cache(const QString &fileName)
+{
+    QAbstractHostInfoLookupManager* manager = theHostInfoLookupManager();
+    QFile file(fileName);
+    if (!manager || !file.open(QIODevice::ReadOnly))
+        return false;
+    return manager->cache.load(&file);
+}
+
 // cache for 60 seconds
 // cache 64 items
 QHostInfoCache::QHostInfoCache() : max_age(60), enabled(true), cache(64)
@@ -770,7 +799,7 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
     *valid = false;
     if (cache.contains(name)) {
         QHostInfoCacheElement *element = cache.object(name);
-        if (element->age.elapsed() < max_age*1000)
+        if (element->elapsed() < qint64(max_age) * 1000)
             *valid = true;
         return element->info;
 
@@ -782,7 +811,7 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
     return QHostInfo();
 }
 
-void QHostInfoCache::put(const QString &name, const QHostInfo &info)
+void QHostInfoCache::put(const QString &name, const QHostInfo &info, qint64 initialAge)
 {
     // if the lookup failed, don't cache
     if (info.error() != QHostInfo::NoError)
@@ -792,6 +821,7 @@ void QHostInfoCache::put(const QString &name, const QHostInfo &info)
     element->info = info;
     element->age = QElapsedTimer();
     element->age.start();
+    element->initialAge = initialAge;
 
     QMutexLocker locker(&this->mutex);
     cache.insert(name, element); // cache will take ownership
@@ -803,6 +833,79 @@ void QHostInfoCache::clear()
     cache.clear();
 }
 
+void QHostInfoCache::setLimits(int maxEntries, int maxAge)
+{
+    QMutexLocker locker(&this->mutex);
+    if (maxEntries >= 0)
+        cache.setMaxCost(maxEntries);
+    if (maxAge >= 0)
+        max_age = maxAge;
+}
+
+static const quint32 QHostInfoCacheMagic = 0x51484943; // "QHIC"
+static const quint32 QHostInfoCacheVersion = 1;
+
+// Entries are stored with the time they were resolved at, so loading them
+// again in another process keeps their age.
+bool QHostInfoCache::save(QIODevice *device)
+{
+    QMutexLocker locker(&this->mutex);
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QDataStream out(device);
+    out.setVersion(QDataStream::Qt_4_8);
+    out << QHostInfoCacheMagic << QHostInfoCacheVersion;
+
+    QList<QString> names;
+    foreach (const QString &name, cache.keys()) {
+        if (cache.object(name)->elapsed() < qint64(max_age) * 1000)
+            names.append(name);
+    }
+
+    out << quint32(names.count());
+    foreach (const QString &name, names) {
+        QHostInfoCacheElement *element = cache.object(name);
+        out << name << (now - element->elapsed()) << element->info.addresses();
+    }
+    return out.status() == QDataStream::Ok;
+}
+
+bool QHostInfoCache::load(QIODevice *device)
+{
+    int maxAge;
+    {
+        QMutexLocker locker(&this->mutex);
+        maxAge = max_age;
+    }
+
+    QDataStream in(device);
+    in.setVersion(QDataStream::Qt_4_8);
+
+    quint32 magic, version, count;
+    in >> magic >> version;
+    if (magic != QHostInfoCacheMagic || version != QHostInfoCacheVersion)
+        return false;
+    in >> count;
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString name;
+        qint64 resolvedAt;
+        QList<QHostAddress> addresses;
+        in >> name >> resolvedAt >> addresses;
+
+        const qint64 age = now - resolvedAt;
+        if (in.status() != QDataStream::Ok || age < 0 || age >= qint64(maxAge) * 1000 || addresses.isEmpty())
+            continue;
+
+        QHostInfo info;
+        info.setHostName(name);
+        info.setAddresses(addresses);
+        put(name, info, age);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
 QAbstractHostInfoLookupManager* QAbstractHostInfoLookupManager::globalInstance()
 {
     return theHostInfoLookupManager();
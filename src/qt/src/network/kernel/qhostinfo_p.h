@@ -66,6 +66,7 @@
 #include "QtCore/qrunnable.h"
 #include "QtCore/qlist.h"
 #include "QtCore/qqueue.h"
+#include "QtCore/qiodevice.h"
 #include <QElapsedTimer>
 #include <QCache>
 
@@ -137,24 +138,33 @@ public:
 QHostInfo Q_NETWORK_EXPORT qt_qhostinfo_lookup(const QString &name, QObject *receiver, const char *member, bool *valid, int *id);
 void Q_AUTOTEST_EXPORT qt_qhostinfo_clear_cache();
 void Q_AUTOTEST_EXPORT qt_qhostinfo_enable_cache(bool e);
+void Q_NETWORK_EXPORT qt_qhostinfo_set_cache_limits(int maxEntries, int maxAge);
+bool Q_NETWORK_EXPORT qt_qhostinfo_save_cache(const QString &fileName);
+bool Q_NETWORK_EXPORT qt_qhostinfo_load_cache(const QString &fileName);
 
 class QHostInfoCache
 {
 public:
     QHostInfoCache();
-    const int max_age; // seconds
+    int max_age; // seconds
 
     QHostInfo get(const QString &name, bool *valid);
-    void put(const QString &name, const QHostInfo &info);
+    void put(const QString &name, const QHostInfo &info, qint64 initialAge = 0);
     void clear();
 
     bool isEnabled();
     void setEnabled(bool e);
+    void setLimits(int maxEntries, int maxAge);
+
+    bool save(QIODevice *device);
+    bool load(QIODevice *device);
 private:
     bool enabled;
     struct QHostInfoCacheElement {
         QHostInfo info;
         QElapsedTimer age;
+        qint64 initialAge; // msecs, for entries loaded from disk
+        qint64 elapsed() const { return initialAge + age.elapsed(); }
     };
     QCache<QString,QHostInfoCacheElement> cache;
     QMutex mutex;
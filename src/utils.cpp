@@ -32,6 +32,8 @@
 #include <QDebug>
 #include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
+#include <QHash>
 #include <QTemporaryFile>
 
 #include "consts.h"
@@ -42,6 +44,18 @@ QTemporaryFile* Utils::m_tempHarness = 0;
 QTemporaryFile* Utils::m_tempWrapper = 0;
 bool Utils::printDebugMessages = false;
 
+// Scripts injected over and over (e.g. into every page opened) are only read
+// and converted again once the file changes
+struct CachedScript
+{
+    QDateTime lastModified;
+    qint64 size;
+    QString encoding;
+    QString body;
+};
+typedef QHash<QString, CachedScript> CachedScriptHash;
+Q_GLOBAL_STATIC(CachedScriptHash, cachedScripts)
+
 void Utils::messageHandler(QtMsgType type, const char *msg)
 {
     QDateTime now = QDateTime::currentDateTime();
@@ -164,6 +178,16 @@ QString Utils::findScript(const QString& jsFilePath, const QString &libraryPath)
 
 QString Utils::jsFromScriptFile(const QString& scriptPath, const Encoding& enc)
 {
+    const QFileInfo info(scriptPath);
+    const QString key = info.absoluteFilePath();
+    CachedScriptHash::const_iterator cached = cachedScripts()->constFind(key);
+    if (cached != cachedScripts()->constEnd() && info.exists()
+            && cached->lastModified == info.lastModified()
+            && cached->size == info.size()
+            && cached->encoding == enc.getName()) {
+        return cached->body;
+    }
+
     QFile jsFile(scriptPath);
     if (jsFile.exists() && jsFile.open(QFile::ReadOnly)) {
         QString scriptBody = enc.decode(jsFile.readAll());
@@ -182,13 +206,19 @@ QString Utils::jsFromScriptFile(const QString& scriptPath, const Encoding& enc)
         }
         jsFile.close();
 
+        CachedScript entry;
+        entry.lastModified = info.lastModified();
+        entry.size = info.size();
+        entry.encoding = enc.getName();
+        entry.body = scriptBody;
+        cachedScripts()->insert(key, entry);
+
         return scriptBody;
     } else {
         return QString();
     }
 }
 
-
 void
 Utils::cleanupFromDebug()
 {
@@ -44,17 +44,20 @@
 #include <QNetworkRequest>
 #include <QPainter>
 #include <QPrinter>
+#include <QPrintEngine>
 #include <QWebHistory>
 #include <QWebHistoryItem>
 #include <QWebElement>
 #include <QWebFrame>
 #include <QWebPage>
 #include <QWebInspector>
+#include <QWebSettings>
 #include <QMapIterator>
 #include <QBuffer>
 #include <QDebug>
 #include <QImageWriter>
 #include <QUuid>
+#include <QTimer>
 
 #include <gifwriter.h>
 
@@ -67,9 +70,23 @@
 #include "cookiejar.h"
 #include "system.h"
 
+#include <fcntl.h>
+
 #ifdef Q_OS_WIN32
 #include <io.h>
-#include <fcntl.h>
+#endif
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef Q_WS_QPA
+QT_BEGIN_NAMESPACE
+// Scale of the headless platform screen (see qheadlessintegration.cpp)
+Q_GUI_EXPORT qreal qt_headless_device_pixel_ratio();
+QT_END_NAMESPACE
 #endif
 
 // Ensure we have at least head and body.
@@ -78,6 +95,15 @@
 #define INPAGE_CALL_NAME                "window.callPhantom"
 #define CALLBACKS_OBJECT_INJECTION      INPAGE_CALL_NAME" = function() { return window."CALLBACKS_OBJECT_NAME".call.call(_phantom, Array.prototype.splice.call(arguments, 0)); };"
 #define CALLBACKS_OBJECT_PRESENT        "typeof(window."CALLBACKS_OBJECT_NAME") !== \"undefined\";"
+#define NAVIGATION_TIMING               "(function () { var t = window.performance && window.performance.timing, r = {};" \
+                                        "for (var k in t) if (typeof t[k] === 'number') r[k] = t[k]; return r; })();"
+
+#define SCRIPT_INTERRUPT_CHECK_INTERVAL     50
+#define SCRIPT_EVENT_PROCESSING_INTERVAL    10000
+
+// Pages with a script timeout or CPU budget, which the interrupt check
+// interval shared by all pages has to be short enough for
+static QList<WebPage *> pagesWithScriptLimits;
 
 #define STDOUT_FILENAME "/dev/stdout"
 #define STDERR_FILENAME "/dev/stderr"
@@ -112,8 +138,7 @@ public:
 
 public slots:
     bool shouldInterruptJavaScript() {
-        QApplication::processEvents(QEventLoop::AllEvents, 42);
-        return false;
+        return m_webPage->shouldInterruptJavaScript();
     }
 
 protected:
@@ -314,6 +339,12 @@ WebPage::WebPage(QObject *parent, const QUrl &baseUrl)
     , m_mousePos(QPoint(0, 0))
     , m_ownsPages(true)
     , m_loadingProgress(0)
+    , m_networkIdleInflight(0)
+    , m_waitingForNetworkIdle(false)
+    , m_waitingForRenderIdle(false)
+    , m_scriptTimeout(0)
+    , m_scriptCpuBudget(0)
+    , m_scriptCpuTime(0)
 {
     setObjectName("WebPage");
     m_callbacks = new WebpageCallbacks(this);
@@ -346,6 +377,19 @@ WebPage::WebPage(QObject *parent, const QUrl &baseUrl)
     connect(m_customWebPage, SIGNAL(loadFinished(bool)), SLOT(finish(bool)), Qt::QueuedConnection);
     connect(m_customWebPage, SIGNAL(windowCloseRequested()), this, SLOT(close()), Qt::QueuedConnection);
     connect(m_customWebPage, SIGNAL(loadProgress(int)), this, SLOT(updateLoadingProgress(int)));
+    connect(m_customWebPage, SIGNAL(javaScriptRunFinished(int)), this, SLOT(chargeScriptRun(int)));
+
+    m_networkIdleTimer = new QTimer(this);
+    m_networkIdleTimer->setSingleShot(true);
+    m_networkIdleTimer->setInterval(500);
+    connect(m_networkIdleTimer, SIGNAL(timeout()), SLOT(emitNetworkIdle()));
+    connect(m_customWebPage, SIGNAL(loadStarted()), SLOT(startWaitingForNetworkIdle()));
+
+    m_renderIdleTimer = new QTimer(this);
+    m_renderIdleTimer->setSingleShot(true);
+    m_renderIdleTimer->setInterval(500);
+    connect(m_renderIdleTimer, SIGNAL(timeout()), SLOT(checkRenderIdle()));
+    connect(m_customWebPage, SIGNAL(repaintRequested(QRect)), SLOT(restartRenderIdleTimer()));
 
     // Start with transparent background.
     QPalette palette = m_customWebPage->palette();
@@ -388,6 +432,10 @@ WebPage::WebPage(QObject *parent, const QUrl &baseUrl)
             SIGNAL(resourceError(QVariant)));
     connect(m_networkAccessManager, SIGNAL(resourceTimeout(QVariant)),
             SIGNAL(resourceTimeout(QVariant)));
+    connect(PendingRequestNotifier::instance(), SIGNAL(totalPendingRequestCountChanged(int)),
+            SLOT(updateVirtualTime()));
+    connect(m_networkAccessManager, SIGNAL(pendingRequestCountChanged(int)),
+            SLOT(updateNetworkIdle()));
 
     m_customWebPage->setViewportSize(QSize(400, 300));
 }
@@ -395,6 +443,9 @@ WebPage::WebPage(QObject *parent, const QUrl &baseUrl)
 WebPage::~WebPage()
 {
     emit closing(this);
+
+    if (pagesWithScriptLimits.removeOne(this))
+        updateScriptInterruptInterval();
 }
 
 QWebFrame *WebPage::mainFrame()
@@ -518,6 +569,139 @@ void WebPage::stop()
     m_customWebPage->triggerAction(QWebPage::Stop);
 }
 
+// Virtual time is process-wide, and so is the wish to fast-forward it
+static bool virtualTimeFastForward = true;
+
+void WebPage::setVirtualTime(const bool enabled, const bool fastForward)
+{
+    virtualTimeFastForward = fastForward;
+    QWebSettings::setVirtualTimeEnabled(enabled);
+    updateVirtualTime();
+}
+
+void WebPage::advanceTime(const int ms)
+{
+    QWebSettings::advanceVirtualTime(ms);
+}
+
+void WebPage::startProfiling(const QString &title)
+{
+    m_mainFrame->startProfiling(title);
+}
+
+QVariantMap WebPage::stopProfiling(const QString &title)
+{
+    return m_mainFrame->stopProfiling(title);
+}
+
+void WebPage::updateVirtualTime()
+{
+    // Only jump ahead while nothing is loading: a response in flight must
+    // not be outrun by the timers waiting for it
+    QWebSettings::setVirtualTimeFastForwardEnabled(QWebSettings::virtualTimeEnabled()
+            && virtualTimeFastForward
+            && NetworkAccessManager::totalPendingRequestCount() == 0);
+}
+
+void WebPage::startWaitingForNetworkIdle()
+{
+    m_waitingForNetworkIdle = true;
+    m_waitingForRenderIdle = false;
+    m_renderIdleTimer->stop();
+    m_networkIdleTimer->stop();
+    updateNetworkIdle();
+}
+
+void WebPage::updateNetworkIdle()
+{
+    if (!m_waitingForNetworkIdle)
+        return;
+
+    // The quiet period only starts over once the page went above the limit:
+    // requests coming and going below it do not postpone the event
+    if (m_networkAccessManager->pendingRequestCount() > m_networkIdleInflight)
+        m_networkIdleTimer->stop();
+    else if (!m_networkIdleTimer->isActive())
+        m_networkIdleTimer->start();
+}
+
+void WebPage::emitNetworkIdle()
+{
+    m_waitingForNetworkIdle = false;
+    emit networkIdle();
+}
+
+void WebPage::restartRenderIdleTimer()
+{
+    if (m_waitingForRenderIdle)
+        m_renderIdleTimer->start();
+}
+
+bool WebPage::shouldInterruptJavaScript()
+{
+    int runTime = QWebSettings::javaScriptRunTime();
+    int sinceCheck = QWebSettings::javaScriptRunTimeSinceInterruptCheck();
+    // The run itself is only charged once it returned (see chargeScriptRun())
+    qint64 totalTime = m_scriptCpuTime + runTime;
+
+    QString reason;
+    if (m_scriptTimeout > 0 && runTime >= m_scriptTimeout)
+        reason = "timeout";
+    else if (m_scriptCpuBudget > 0 && totalTime >= m_scriptCpuBudget)
+        reason = "budget";
+
+    if (!reason.isEmpty()) {
+        QVariantMap data;
+        data["reason"] = reason;
+        data["runTime"] = runTime;
+        data["totalTime"] = totalTime;
+        // The aborted script is still on the stack: report it once it unwound
+        QMetaObject::invokeMethod(this, "scriptTimeout", Qt::QueuedConnection, Q_ARG(QVariant, data));
+        return true;
+    }
+
+    // Keep the application responsive during long scripts, as often as before
+    // the interval could be shortened
+    if ((runTime - sinceCheck) / SCRIPT_EVENT_PROCESSING_INTERVAL != runTime / SCRIPT_EVENT_PROCESSING_INTERVAL)
+        QApplication::processEvents(QEventLoop::AllEvents, 42);
+    return false;
+}
+
+void WebPage::chargeScriptRun(int msecs)
+{
+    m_scriptCpuTime += msecs;
+}
+
+void WebPage::updateScriptInterruptInterval()
+{
+    // Back to the WebKit default once no page has limits any more
+    int interval = SCRIPT_EVENT_PROCESSING_INTERVAL;
+    foreach (WebPage *page, pagesWithScriptLimits) {
+        int limit = page->m_scriptTimeout > 0 ? page->m_scriptTimeout : page->m_scriptCpuBudget;
+        if (page->m_scriptCpuBudget > 0)
+            limit = qMin(limit, page->m_scriptCpuBudget);
+        interval = qMin(interval, qMin(SCRIPT_INTERRUPT_CHECK_INTERVAL, limit));
+    }
+    if (interval != QWebSettings::javaScriptInterruptInterval())
+        QWebSettings::setJavaScriptInterruptInterval(interval);
+}
+
+void WebPage::checkRenderIdle()
+{
+    if (!m_waitingForRenderIdle)
+        return;
+
+    // Work that is about to change the rendering postpones the event as
+    // much as a repaint does
+    if (m_mainFrame->hasPendingRenderWork(m_renderIdleTimer->interval())) {
+        m_renderIdleTimer->start();
+        return;
+    }
+
+    m_waitingForRenderIdle = false;
+    emit renderIdle();
+}
+
 
 QString WebPage::plainText() const
 {
@@ -589,6 +773,25 @@ void WebPage::applySettings(const QVariantMap &def)
     if (def.contains(PAGE_SETTINGS_RESOURCE_TIMEOUT))
         m_networkAccessManager->setResourceTimeout(def[PAGE_SETTINGS_RESOURCE_TIMEOUT].toInt());
 
+    if (def.contains(PAGE_SETTINGS_NETWORK_IDLE_TIMEOUT))
+        m_networkIdleTimer->setInterval(def[PAGE_SETTINGS_NETWORK_IDLE_TIMEOUT].toInt());
+
+    if (def.contains(PAGE_SETTINGS_NETWORK_IDLE_INFLIGHT))
+        m_networkIdleInflight = def[PAGE_SETTINGS_NETWORK_IDLE_INFLIGHT].toInt();
+
+    if (def.contains(PAGE_SETTINGS_RENDER_IDLE_TIMEOUT))
+        m_renderIdleTimer->setInterval(def[PAGE_SETTINGS_RENDER_IDLE_TIMEOUT].toInt());
+
+    if (def.contains(PAGE_SETTINGS_SCRIPT_TIMEOUT))
+        m_scriptTimeout = def[PAGE_SETTINGS_SCRIPT_TIMEOUT].toInt();
+
+    if (def.contains(PAGE_SETTINGS_SCRIPT_CPU_BUDGET))
+        m_scriptCpuBudget = def[PAGE_SETTINGS_SCRIPT_CPU_BUDGET].toInt();
+
+    pagesWithScriptLimits.removeOne(this);
+    if (m_scriptTimeout > 0 || m_scriptCpuBudget > 0)
+        pagesWithScriptLimits.append(this);
+    updateScriptInterruptInterval();
 }
 
 QString WebPage::userAgent() const
@@ -732,6 +935,10 @@ bool WebPage::javaScriptPrompt(const QString &msg, const QString &defaultValue,
 void WebPage::finish(bool ok)
 {
     QString status = ok ? "success" : "fail";
+    if (ok) {
+        m_waitingForRenderIdle = true;
+        m_renderIdleTimer->start();
+    }
     emit loadFinished(status);
 }
 
@@ -745,6 +952,16 @@ QVariantMap WebPage::customHeaders() const
     return m_networkAccessManager->customHeaders();
 }
 
+void WebPage::setNetworkConditions(const QVariantMap &conditions)
+{
+    m_networkAccessManager->setNetworkConditions(conditions);
+}
+
+QVariantMap WebPage::networkConditions() const
+{
+    return m_networkAccessManager->networkConditions();
+}
+
 bool WebPage::setCookies(const QVariantList &cookies)
 {
     // Delete all the cookies for this URL
@@ -851,6 +1068,17 @@ void WebPage::close() {
     deleteLater();
 }
 
+// Encoders that write an alpha channel expect straight colors, the others
+// read the color channels of a premultiplied image as they are
+static QImage imageForEncoding(const QImage &image, const QString &format)
+{
+    const QString f = format.toLower();
+    if (image.format() == QImage::Format_ARGB32_Premultiplied && f != "jpg" && f != "jpeg") {
+        return image.convertToFormat(QImage::Format_ARGB32);
+    }
+    return image;
+}
+
 bool WebPage::render(const QString &fileName, const QVariantMap &option)
 {
     if (m_mainFrame->contentsSize().isEmpty())
@@ -861,6 +1089,7 @@ bool WebPage::render(const QString &fileName, const QVariantMap &option)
 
     QString format = "";
     int quality = -1; // QImage#save default
+    bool fastEncoding = false;
 
     if( fileName == STDOUT_FILENAME || fileName == STDERR_FILENAME ){
         if( !QFile::exists(fileName) ){
@@ -888,26 +1117,46 @@ bool WebPage::render(const QString &fileName, const QVariantMap &option)
     }
 
     if( option.contains("quality") ){
-        quality = option.value("quality").toInt();
+        if( option.value("quality").toString() == "fast" ){
+            fastEncoding = true;
+        } else {
+            quality = option.value("quality").toInt();
+        }
+    }
+
+    // An opaque background lets the page be painted without an alpha channel
+    QColor background;
+    if( option.contains("background") ){
+        background = QColor(option.value("background").toString());
     }
 
     bool retval = true;
     if ( format == "pdf" ){
-        retval = renderPdf(outFileName);
+        retval = renderPdf(outFileName, option);
     }
     else if ( format == "gif" ) {
-        QImage rawPageRendering = renderImage();
+        QImage rawPageRendering = imageForEncoding(renderImage(background), "gif");
         retval = exportGif(rawPageRendering, outFileName);
     }
     else{
-        QImage rawPageRendering = renderImage();
+        QString encoderFormat = format;
+        if( encoderFormat == "" ){
+            encoderFormat = QFileInfo(outFileName).suffix();
+        }
+        QImage rawPageRendering = imageForEncoding(renderImage(background), encoderFormat);
 
         const char *f = 0; // 0 is QImage#save default
         if( format != "" ){
             f = format.toUtf8().constData();
         }
 
-        retval = rawPageRendering.save(outFileName, f, quality);
+        QImageWriter writer(outFileName, f);
+        writer.setQuality(quality);
+        // PNG only: speed over file size (compression "1" picks the fast encoder)
+        if( fastEncoding ){
+            writer.setCompression(1);
+        }
+        retval = writer.write(rawPageRendering);
     }
 
     if( tempFileName != "" ){
@@ -949,13 +1198,17 @@ bool WebPage::render(const QString &fileName, const QVariantMap &option)
     return retval;
 }
 
-QString WebPage::renderBase64(const QByteArray &format)
+QString WebPage::renderBase64(const QByteArray &format, const QVariantMap &options)
 {
     QByteArray nformat = format.toLower();
 
     // Check if the given format is supported
     if (QImageWriter::supportedImageFormats().contains(nformat)) {
-        QImage rawPageRendering = renderImage();
+        QColor background;
+        if (options.contains("background")) {
+            background = QColor(options.value("background").toString());
+        }
+        QImage rawPageRendering = imageForEncoding(renderImage(background), nformat);
 
         // Prepare buffer for writing
         QByteArray bytes;
@@ -972,7 +1225,131 @@ QString WebPage::renderBase64(const QByteArray &format)
     return "";
 }
 
-QImage WebPage::renderImage()
+#ifdef Q_OS_UNIX
+// Header of the frames written by renderToSharedMemory(), see webpage.h
+struct SharedFrameHeader
+{
+    quint32 magic;
+    quint32 headerSize;
+    quint32 width;
+    quint32 height;
+    quint32 stride;
+    quint32 format;
+    quint32 dataSize;
+    volatile quint32 sequence;
+    char encoding[8];
+    quint32 reserved[6];
+};
+
+#define SHARED_FRAME_MAGIC              0x46534a50 // "PJSF"
+#endif
+
+bool WebPage::renderToSharedMemory(const QString &name, const QVariantMap &options)
+{
+#ifdef Q_OS_UNIX
+    if (m_mainFrame->contentsSize().isEmpty())
+        return false;
+
+    QColor background;
+    if (options.contains("background")) {
+        background = QColor(options.value("background").toString());
+    }
+    const QString format = options.value("format", "raw").toString().toLower();
+
+    QImage image = renderImage(background);
+    QByteArray encoded;
+    if (format != "raw") {
+        image = imageForEncoding(image, format);
+        QBuffer buffer(&encoded);
+        buffer.open(QIODevice::WriteOnly);
+        QImageWriter writer(&buffer, format.toLatin1());
+        if (options.value("quality").toString() == "fast") {
+            writer.setCompression(1);
+        } else if (options.contains("quality")) {
+            writer.setQuality(options.value("quality").toInt());
+        }
+        if (!writer.write(image))
+            return false;
+    }
+
+    const quint32 dataSize = format == "raw" ? image.byteCount() : encoded.size();
+    const size_t size = sizeof(SharedFrameHeader) + dataSize;
+
+    const QByteArray shmName = QFile::encodeName(name);
+    int fd = ::shm_open(shmName.constData(), O_RDWR | O_CREAT, 0600);
+    if (fd == -1) {
+        qWarning() << "renderToSharedMemory: cannot open" << name;
+        return false;
+    }
+
+    // Carry the sequence number over from the previous frame; an odd one is
+    // left by a writer that died mid-frame
+    quint32 sequence = 0;
+    size_t mappingSize = 0;
+    struct stat st;
+    if (::fstat(fd, &st) == 0) {
+        mappingSize = st.st_size;
+        SharedFrameHeader previous;
+        if (mappingSize >= sizeof(SharedFrameHeader)
+                && ::pread(fd, &previous, sizeof(previous), 0) == (ssize_t) sizeof(previous)
+                && previous.magic == SHARED_FRAME_MAGIC) {
+            sequence = (previous.sequence + 1) & ~1u;
+        }
+    }
+
+    // Only ever grown: shrinking would make readers that mapped the larger
+    // object fault on the pages cut off
+    if (mappingSize < size) {
+        if (::ftruncate(fd, size) == -1) {
+            ::close(fd);
+            return false;
+        }
+        mappingSize = size;
+    }
+    void *mapping = ::mmap(0, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+        return false;
+
+    SharedFrameHeader *header = static_cast<SharedFrameHeader *>(mapping);
+    uchar *data = static_cast<uchar *>(mapping) + sizeof(SharedFrameHeader);
+
+    // Odd while the frame is written, so that readers can tell a torn copy
+    header->sequence = sequence + 1;
+    __sync_synchronize();
+
+    header->magic = SHARED_FRAME_MAGIC;
+    header->headerSize = sizeof(SharedFrameHeader);
+    header->width = image.width();
+    header->height = image.height();
+    memset(header->encoding, 0, sizeof(header->encoding));
+    strncpy(header->encoding, format.toLatin1().constData(), sizeof(header->encoding) - 1);
+    memset(header->reserved, 0, sizeof(header->reserved));
+    if (format == "raw") {
+        header->stride = image.bytesPerLine();
+        header->format = image.format();
+        memcpy(data, image.constBits(), dataSize);
+    } else {
+        header->stride = 0;
+        header->format = QImage::Format_Invalid;
+        memcpy(data, encoded.constData(), dataSize);
+    }
+    header->dataSize = dataSize;
+
+    __sync_synchronize();
+    header->sequence = sequence + 2;
+
+    ::munmap(mapping, mappingSize);
+    return true;
+#else
+    Q_UNUSED(name);
+    Q_UNUSED(options);
+    qWarning() << "renderToSharedMemory: not supported on this platform";
+    return false;
+#endif
+}
+
+QImage WebPage::renderImage(const QColor &background)
 {
     QSize contentsSize = m_mainFrame->contentsSize();
     contentsSize -= QSize(m_scrollPosition.x(), m_scrollPosition.y());
@@ -983,14 +1360,22 @@ QImage WebPage::renderImage()
     QSize viewportSize = m_customWebPage->viewportSize();
     m_customWebPage->setViewportSize(contentsSize);
 
-#ifdef Q_OS_WIN32
-    QImage::Format format = QImage::Format_ARGB32_Premultiplied;
+    // The raster engine composes premultiplied pixels directly; without
+    // an alpha channel there is nothing to blend with at all
+    const bool opaque = background.isValid() && background.alpha() == 255;
+    QImage::Format format = opaque ? QImage::Format_RGB32 : QImage::Format_ARGB32_Premultiplied;
+    const QColor fillColor = background.isValid() ? background : QColor(Qt::transparent);
+
+    // On a HiDPI screen every CSS pixel covers several device pixels; the
+    // page is painted scaled up so that text and vectors stay crisp
+#ifdef Q_WS_QPA
+    const qreal ratio = qt_headless_device_pixel_ratio();
 #else
-    QImage::Format format = QImage::Format_ARGB32;
+    const qreal ratio = 1.0;
 #endif
 
-    QImage buffer(frameRect.size(), format);
-    buffer.fill(Qt::transparent);
+    QImage buffer(frameRect.size() * ratio, format);
+    buffer.fill(fillColor);
 
     QPainter painter;
 
@@ -1003,16 +1388,19 @@ QImage WebPage::renderImage()
     for (int x = 0; x < htiles; ++x) {
         for (int y = 0; y < vtiles; ++y) {
 
+            const qint64 tileTraceStart = QWebSettings::traceTimestamp();
+
             QImage tileBuffer(tileSize, tileSize, format);
-            tileBuffer.fill(Qt::transparent);
+            tileBuffer.fill(fillColor);
 
             // Render the web page onto the small tile first
             painter.begin(&tileBuffer);
             painter.setRenderHint(QPainter::Antialiasing, true);
             painter.setRenderHint(QPainter::TextAntialiasing, true);
             painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
-            painter.translate(-frameRect.left(), -frameRect.top());
             painter.translate(-x * tileSize, -y * tileSize);
+            painter.scale(ratio, ratio);
+            painter.translate(-frameRect.left(), -frameRect.top());
             m_mainFrame->render(&painter, QRegion(frameRect));
             painter.end();
 
@@ -1021,6 +1409,14 @@ QImage WebPage::renderImage()
             painter.setCompositionMode(QPainter::CompositionMode_Source);
             painter.drawImage(x * tileSize, y * tileSize, tileBuffer);
             painter.end();
+
+            if (tileTraceStart >= 0) {
+                QVariantMap args;
+                args["x"] = x;
+                args["y"] = y;
+                QWebSettings::addTraceEvent("paint", "WebPage::renderImage tile", tileTraceStart,
+                                            QWebSettings::traceTimestamp() - tileTraceStart, args);
+            }
         }
     }
 
@@ -1062,12 +1458,16 @@ qreal printMargin(const QVariantMap &map, const QString &key)
     }
 }
 
-bool WebPage::renderPdf(const QString &fileName)
+bool WebPage::renderPdf(const QString &fileName, const QVariantMap &option)
 {
     QPrinter printer;
     printer.setOutputFormat(QPrinter::PdfFormat);
     printer.setOutputFileName(fileName);
     printer.setResolution(PHANTOMJS_PDF_DPI);
+    // How images get encoded: 'lossless', 'jpeg' or 'auto' (default) to choose per image
+    if (option.contains("imageCompression")) {
+        printer.printEngine()->setProperty(QPrintEngine::PPK_ImageCompression, option.value("imageCompression"));
+    }
     QVariantMap paperSize = m_paperSize;
 
     if (paperSize.isEmpty()) {
@@ -1180,6 +1580,11 @@ QString WebPage::windowName() const
     return m_mainFrame->evaluateJavaScript("window.name;").toString();
 }
 
+QVariantMap WebPage::navigationTiming() const
+{
+    return m_mainFrame->evaluateJavaScript(NAVIGATION_TIMING).toMap();
+}
+
 qreal getHeight(const QVariantMap &map, const QString &key)
 {
     QVariant footer = map.value(key);
@@ -31,6 +31,7 @@
 #ifndef WEBPAGE_H
 #define WEBPAGE_H
 
+#include <QColor>
 #include <QMap>
 #include <QVariantMap>
 #include <QWebPage>
@@ -41,6 +42,7 @@ class CustomPage;
 class WebpageCallbacks;
 class NetworkAccessManager;
 class QWebInspector;
+class QTimer;
 class Phantom;
 
 class WebPage : public QObject, public QWebFrame::PrintCallback
@@ -67,9 +69,11 @@ class WebPage : public QObject, public QWebFrame::PrintCallback
     Q_PROPERTY(QVariantMap scrollPosition READ scrollPosition WRITE setScrollPosition)
     Q_PROPERTY(bool navigationLocked READ navigationLocked WRITE setNavigationLocked)
     Q_PROPERTY(QVariantMap customHeaders READ customHeaders WRITE setCustomHeaders)
+    Q_PROPERTY(QVariantMap networkConditions READ networkConditions)
     Q_PROPERTY(qreal zoomFactor READ zoomFactor WRITE setZoomFactor)
     Q_PROPERTY(QVariantList cookies READ cookies WRITE setCookies)
     Q_PROPERTY(QString windowName READ windowName)
+    Q_PROPERTY(QVariantMap navigationTiming READ navigationTiming)
     Q_PROPERTY(QObjectList pages READ pages)
     Q_PROPERTY(QStringList pagesWindowName READ pagesWindowName)
     Q_PROPERTY(bool ownsPages READ ownsPages WRITE setOwnsPages)
@@ -126,6 +130,8 @@ public:
     void setCustomHeaders(const QVariantMap &headers);
     QVariantMap customHeaders() const;
 
+    QVariantMap networkConditions() const;
+
     void showInspector(const int remotePort = -1);
 
     QString footer(int page, int numPages);
@@ -148,6 +154,18 @@ public:
      */
     QString windowName() const;
 
+    /**
+     * Navigation Timing of the document in the main page frame, i.e. a copy
+     * of <code>"window.performance.timing"</code>: milliseconds since the epoch
+     * of <code>"navigationStart"</code>, <code>"domainLookupStart"</code>,
+     * <code>"connectStart"</code>, <code>"responseStart"</code>,
+     * <code>"loadEventEnd"</code> and so on, 0 for the events yet to happen.
+     *
+     * @brief navigationTiming
+     * @return The timing marks, empty if the build has no Navigation Timing
+     */
+    QVariantMap navigationTiming() const;
+
     /**
      * Returns a list of (Child) Pages that this page has currently open.
      * A page opens chilp pages when using <code>"window.open()"</code>.
@@ -247,11 +265,47 @@ public slots:
      * Available formats are the one supported by Qt QImageWriter class:
      * @link http://qt-project.org/doc/qt-4.8/qimagewriter.html#supportedImageFormats.
      *
+     * The only option is the "background", as for render().
+     *
      * @brief renderBase64
      * @param format String containing one of the supported types
+     * @param options Map of options
      * @return Rendering base-64 encoded of the page if the given format is supported, otherwise an empty string
      */
-    QString renderBase64(const QByteArray &format = "png");
+    QString renderBase64(const QByteArray &format = "png", const QVariantMap &options = QVariantMap());
+    /**
+     * Render the page into the POSIX shared memory object called name
+     * (e.g. "/phantomjs-frame"), for another process on the same host to map.
+     *
+     * The object starts with a 64 byte header of native endian 32 bit fields:
+     * <pre>
+     *   magic ('PJSF'), header size, width, height, stride,
+     *   pixel format (a QImage::Format, 0 if encoded), data size, sequence number,
+     *   encoding (8 bytes: "raw", "png", "jpg", ...), then reserved space
+     * </pre>
+     * followed by the data. The object is never shrunk, so it can be larger
+     * than the header and data of the current frame.
+     *
+     * The sequence number is odd while a frame is being written and goes up
+     * by two with every frame. To take a consistent copy, readers:
+     * <pre>
+     *   1. read the sequence number, and start over while it is odd;
+     *   2. copy the header and the data, mapping the object again first if
+     *      header size + data size exceeds what they mapped;
+     *   3. read the sequence number again, and start over if it changed.
+     * </pre>
+     * with a read barrier after step 1 and before step 3.
+     *
+     * Options are the "format" ("raw", the default, for the pixels as rendered,
+     * or any format supported by QImageWriter), "quality" and "background" as
+     * for render().
+     *
+     * @brief renderToSharedMemory
+     * @param name Name of the shared memory object, created if needed
+     * @param options Map of options
+     * @return "true" if the frame was written
+     */
+    bool renderToSharedMemory(const QString &name, const QVariantMap &options = QVariantMap());
     bool injectJs(const QString &jsFilePath);
     void _appendScriptElement(const QString &scriptUrl);
     QObject *_getGenericCallback();
@@ -459,6 +513,67 @@ public slots:
      */
     void stop();
 
+    /**
+     * Switches virtual time on or off.
+     *
+     * While virtual time is on, timers, animations and <code>"Date.now()"</code>
+     * follow a clock that only moves through <code>"advanceTime(ms)"</code>,
+     * or by jumping to the next pending timer whenever no network request
+     * is in flight (if <code>fastForward</code> is "true").
+     * NOTE: The clock is shared by all the pages of the process.
+     *
+     * @brief setVirtualTime
+     * @param enabled "true" to switch to virtual time, "false" to go back to real time
+     * @param fastForward Whether to fast-forward the clock while idle
+     */
+    void setVirtualTime(const bool enabled, const bool fastForward = true);
+    /**
+     * Moves the virtual clock forward, firing the timers that become due on
+     * the way, each at its own time. Does nothing unless virtual time is on.
+     *
+     * @brief advanceTime
+     * @param ms Number of milliseconds to advance the clock by
+     */
+    void advanceTime(const int ms);
+
+    /**
+     * Starts profiling the JavaScript run in the main frame of the page.
+     * Profiles with different titles can overlap.
+     *
+     * @brief startProfiling
+     * @param title Title of the profile
+     */
+    void startProfiling(const QString &title = QString());
+    /**
+     * Stops a profile started with <code>"startProfiling(title)"</code>, or
+     * the most recent one if no title is given.
+     * Pass the result to <code>"phantom.toCpuProfile()"</code> to get a
+     * <code>".cpuprofile"</code> that the Chrome DevTools can load.
+     *
+     * @brief stopProfiling
+     * @param title Title of the profile
+     * @return The call tree: "title", "totalTime" and a "head" node, where every node has
+     *         "functionName", "url", "lineNumber", "callCount", "selfTime", "totalTime" (in ms)
+     *         and "children". Empty if no such profile is running.
+     */
+    QVariantMap stopProfiling(const QString &title = QString());
+
+    /**
+     * Emulates the network the page is on, for the requests it makes from now on.
+     * Responses arrive <code>"latencyMs"</code> ms late, plus the time their
+     * request body takes to upload at <code>"uploadKbps"</code>, and their data
+     * is paced at <code>"downloadKbps"</code> for all of them together.
+     * <code>"packetLossPercent"</code> of the downloaded segments are lost
+     * and only arrive after a retransmission timeout.
+     * A value of 0 (the default) means no limit. With <code>"offline"</code>
+     * every request but to local content fails.
+     *
+     * @brief setNetworkConditions
+     * @param conditions Map with "latencyMs", "downloadKbps", "uploadKbps",
+     *        "packetLossPercent" and "offline"
+     */
+    void setNetworkConditions(const QVariantMap &conditions);
+
 signals:
     void initialized();
     void loadStarted();
@@ -474,15 +589,45 @@ signals:
     void navigationRequested(const QUrl &url, const QString &navigationType, bool navigationLocked, bool isMainFrame);
     void rawPageCreated(QObject *page);
     void closing(QObject *page);
+    /**
+     * Emitted once per page load, as soon as no more than
+     * <code>"settings.networkIdleInflight"</code> requests (default 0) have
+     * been in flight for <code>"settings.networkIdleTimeout"</code> ms (default 500).
+     */
+    void networkIdle();
+    /**
+     * Emitted once per successful page load, as soon as the page has gone
+     * <code>"settings.renderIdleTimeout"</code> ms (default 500) without
+     * repainting, with no layout pending and no <code>"setTimeout()"</code>
+     * callback due within that time.
+     */
+    void renderIdle();
+    /**
+     * Emitted after a script of the page was aborted, either because a single
+     * run took more than <code>"settings.scriptTimeoutMs"</code> ms of CPU time
+     * (reason <code>"timeout"</code>) or because the page used up the
+     * <code>"settings.scriptCpuBudgetMs"</code> ms it was allowed in total
+     * (reason <code>"budget"</code>). Data also holds the <code>"runTime"</code>
+     * of the aborted run and the <code>"totalTime"</code> of the page, in ms.
+     */
+    void scriptTimeout(const QVariant &data);
 
 private slots:
     void finish(bool ok);
     void setupFrame(QWebFrame *frame = NULL);
     void updateLoadingProgress(int progress);
+    void updateVirtualTime();
+    void startWaitingForNetworkIdle();
+    void updateNetworkIdle();
+    void emitNetworkIdle();
+    void restartRenderIdleTimer();
+    void checkRenderIdle();
+    void chargeScriptRun(int msecs);
 
 private:
-    QImage renderImage();
-    bool renderPdf(const QString &fileName);
+    static void updateScriptInterruptInterval();
+    QImage renderImage(const QColor &background = QColor());
+    bool renderPdf(const QString &fileName, const QVariantMap &option = QVariantMap());
     void applySettings(const QVariantMap &defaultSettings);
     QString userAgent() const;
 
@@ -497,6 +642,7 @@ private:
     QString filePicker(const QString &oldFile);
     bool javaScriptConfirm(const QString &msg);
     bool javaScriptPrompt(const QString &msg, const QString &defaultValue, QString *result);
+    bool shouldInterruptJavaScript();
 
 private:
     CustomPage *m_customWebPage;
@@ -513,6 +659,14 @@ private:
     QPoint m_mousePos;
     bool m_ownsPages;
     int m_loadingProgress;
+    QTimer *m_networkIdleTimer;
+    QTimer *m_renderIdleTimer;
+    int m_networkIdleInflight;
+    bool m_waitingForNetworkIdle;
+    bool m_waitingForRenderIdle;
+    int m_scriptTimeout;
+    int m_scriptCpuBudget;
+    qint64 m_scriptCpuTime;
 
     friend class Phantom;
     friend class CustomPage;
@@ -0,0 +1,7 @@
+// Prints the width of a line of text laid out with the fonts of this process
+var page = require('webpage').create();
+page.setContent('<html><body><span id="text" style="font: 20px serif">The quick brown fox</span></body></html>', 'http://localhost/');
+console.log(page.evaluate(function () {
+    return document.getElementById('text').offsetWidth;
+}));
+phantom.exit();
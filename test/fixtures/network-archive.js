@@ -0,0 +1,57 @@
+// Loads the pages of the network archive spec from the server given as
+// argument, or from the archive when replaying, then prints what it got as JSON
+var system = require('system');
+var base = system.args[1];
+var replaying = system.args[2] === "replay";
+var page = require('webpage').create();
+var result = { responses: {}, errors: {} };
+
+page.onResourceReceived = function (response) {
+    if (response.stage === "end") {
+        var headers = {};
+        response.headers.forEach(function (header) {
+            headers[header.name] = header.value;
+        });
+        result.responses[response.url.replace(base, "")] = {
+            status: response.status,
+            statusText: response.statusText,
+            headers: headers
+        };
+    }
+};
+
+page.onResourceError = function (error) {
+    result.errors[error.url.replace(base, "")] = error.errorCode;
+};
+
+function text() {
+    return page.evaluate(function () {
+        return document.body.innerText;
+    });
+}
+
+function done() {
+    console.log(JSON.stringify(result));
+    phantom.exit();
+}
+
+page.open(base + "/page", function (status) {
+    result.page = { status: status, text: text() };
+    result.cookies = page.cookies.map(function (cookie) {
+        return cookie.name + "=" + cookie.value;
+    });
+
+    page.open(base + "/redirect", function (status) {
+        result.redirect = { status: status, url: page.url.replace(base, ""), text: text() };
+
+        // Never recorded
+        if (replaying) {
+            page.open(base + "/missing", function (status) {
+                result.missing = status;
+                done();
+            });
+        } else {
+            done();
+        }
+    });
+});
@@ -0,0 +1,11 @@
+// Opens the URL given as argument, if any, then exits
+var url = require('system').args[1];
+
+if (url) {
+    require('webpage').create().open(url, function (status) {
+        console.log(status);
+        phantom.exit();
+    });
+} else {
+    phantom.exit();
+}
@@ -0,0 +1,42 @@
+// Prints, as JSON, base64 PNG renders of content composed with source-over,
+// with and without a constant alpha, and of smoothly upscaled and rotated
+// images, which go through the bilinear fetch
+var page = require('webpage').create();
+
+// Odd widths, so that the vector loops also have a tail to blend
+var layers =
+    '<canvas id="c" width="301" height="67"></canvas>' +
+    '<script>var c = document.getElementById("c").getContext("2d");' +
+    'var g = c.createLinearGradient(0, 0, 301, 0);' +
+    'g.addColorStop(0, "rgba(255, 0, 0, 0.1)"); g.addColorStop(0.5, "rgba(0, 255, 0, 0.7)"); g.addColorStop(1, "rgba(0, 0, 255, 0.4)");' +
+    'for (var i = 0; i < 67; i += 3) { c.fillStyle = "rgba(" + (i * 3) + ", 90, " + (255 - i * 3) + ", " + (i / 67) + ")"; c.fillRect(0, i, 301, 3); }' +
+    'c.fillStyle = g; c.fillRect(7, 5, 287, 57);</script>';
+
+// A small translucent source, drawn larger than it is with smoothing on
+function transformed(transform) {
+    return '<canvas id="t" width="301" height="67"></canvas>' +
+        '<script>var s = document.createElement("canvas"); s.width = 19; s.height = 7;' +
+        'var sc = s.getContext("2d");' +
+        'for (var x = 0; x < 19; ++x) { sc.fillStyle = "rgba(" + (x * 13) + ", " + (255 - x * 11) + ", " + (x * 7) + ", " + ((x + 3) / 22) + ")"; sc.fillRect(x, 0, 1, 7); }' +
+        'sc.fillStyle = "rgba(255, 255, 255, 0.5)"; sc.fillRect(0, 3, 19, 1);' +
+        'var t = document.getElementById("t").getContext("2d");' +
+        transform + ' t.drawImage(s, 0, 0, 301, 67);</script>';
+}
+
+var cases = {
+    sourceOver: layers,
+    constantAlpha: '<div style="opacity: 0.6">' + layers + '</div>',
+    scaled: transformed(''),
+    rotated: transformed('t.translate(150, -20); t.rotate(0.3); t.scale(0.8, 1.3);')
+};
+
+var result = {};
+page.viewportSize = { width: 301, height: 67 };
+for (var name in cases) {
+    if (cases.hasOwnProperty(name)) {
+        page.setContent('<html><body style="margin: 0; background: rgb(200, 120, 40)">' + cases[name] + '</body></html>', 'http://localhost/');
+        result[name] = page.renderBase64('png');
+    }
+}
+console.log(JSON.stringify(result));
+phantom.exit();
@@ -0,0 +1,13 @@
+// Prints, as JSON, the size of a PNG capture of a 200x100 page
+var page = require('webpage').create();
+page.viewportSize = { width: 200, height: 100 };
+page.setContent('<html><body style="margin: 0; width: 200px; height: 100px; background: red"></body></html>', 'http://localhost/');
+
+// Big-endian width and height of the IHDR chunk
+var png = atob(page.renderBase64('png'));
+function field(offset) {
+    return ((png.charCodeAt(offset) << 24) | (png.charCodeAt(offset + 1) << 16)
+        | (png.charCodeAt(offset + 2) << 8) | png.charCodeAt(offset + 3)) >>> 0;
+}
+console.log(JSON.stringify({ width: field(16), height: field(20) }));
+phantom.exit();
@@ -216,4 +216,51 @@ describe("Basic Files API (read, write, remove, ...)", function() {
         } catch (e) { }
         expect(content).toEqual(output);
     });
+
+    it("should be read/write binary data as bytes", function() {
+        var content, output;
+        try {
+            var f = fs.open(FILENAME_BIN, "wb");
+            f.write(String.fromCharCode(0, 1, 2, 3, 4, 255));
+            f.close();
+
+            f = fs.open(FILENAME_BIN, "rb");
+            output = f.readBytes();
+            f.close();
+
+            f = fs.open(FILENAME_BIN, "wb");
+            f.writeBytes(output);
+            f.close();
+
+            f = fs.open(FILENAME_BIN, "rb");
+            content = f.readBytes(3);
+            f.close();
+
+            fs.remove(FILENAME_BIN);
+        } catch (e) { }
+        expect(output.length).toEqual(6);
+        expect(output[5]).toEqual(255);
+        expect(content.length).toEqual(3);
+        expect(content[0]).toEqual(0);
+        expect(content[2]).toEqual(2);
+    });
+
+    it("should be able to map a file into memory", function() {
+        var size, bytes, text;
+        try {
+            fs.write(FILENAME_BIN, String.fromCharCode(0, 1, 2, 3, 4, 5), "b");
+
+            var m = fs.mmap(FILENAME_BIN);
+            size = m.size;
+            bytes = m.readBytes(4, 10);
+            text = m.read(0, 2);
+            m.close();
+
+            fs.remove(FILENAME_BIN);
+        } catch (e) { }
+        expect(size).toEqual(6);
+        expect(bytes.length).toEqual(2);
+        expect(bytes[1]).toEqual(5);
+        expect(text).toEqual(String.fromCharCode(0, 1));
+    });
 });
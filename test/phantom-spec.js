@@ -72,6 +72,242 @@ describe("phantom global object", function() {
         expect(phantom.cookiesEnabled).toBeTruthy();
     });
 
+    it("should have 'memoryCache' property with the default WebKit capacities", function() {
+        expect(phantom.memoryCache.size).toEqual(8192);
+        expect(phantom.memoryCache.maxDeadSize).toEqual(8192);
+        expect(phantom.memoryCache.minDeadSize).toEqual(0);
+        expect(phantom.memoryCache.pruneDecodedImagesFirst).toBeFalsy();
+    });
+
+    it("should be able to change the memory cache capacities", function() {
+        phantom.memoryCache = { size: 4096, maxDeadSize: 16384 };
+        expect(phantom.memoryCache.size).toEqual(4096);
+        expect(phantom.memoryCache.maxDeadSize).toEqual(4096);
+        phantom.memoryCache = { size: 8192, maxDeadSize: 8192 };
+        expect(phantom.memoryCache.size).toEqual(8192);
+    });
+
+    it("should report memory cache statistics per resource type", function() {
+        var stats = phantom.memoryCacheStatistics();
+        expect(typeof stats.images.count).toEqual("number");
+        expect(typeof stats.scripts.decodedSize).toEqual("number");
+        expect(stats.capacity).toEqual(8192 * 1024);
+    });
+
+    it("should share the parse information of identical scripts across pages", function() {
+        var fs = require('fs');
+        var dir = fs.workingDirectory + '/parse-cache-test';
+        var body = 'function shared() { var total = 0; for (var i = 0; i < 10; ++i) { total += i * i; } return total; }';
+        var results = [];
+        var before, after;
+
+        runs(function() {
+            fs.makeDirectory(dir);
+            fs.write(dir + '/a.js', body, 'w');
+            fs.write(dir + '/b.js', body, 'w');
+            fs.write(dir + '/a.html', '<html><head><script src="a.js"></script></head></html>', 'w');
+            fs.write(dir + '/b.html', '<html><head><script src="b.js"></script></head></html>', 'w');
+            before = phantom.scriptParseCacheStatistics();
+
+            var first = require('webpage').create();
+            first.open('file://' + dir + '/a.html', function () {
+                results.push(first.evaluate(function () { return shared(); }));
+                first.close();
+
+                var second = require('webpage').create();
+                second.open('file://' + dir + '/b.html', function () {
+                    results.push(second.evaluate(function () { return shared(); }));
+                    second.close();
+                });
+            });
+        });
+
+        waitsFor(function() {
+            return results.length === 2;
+        }, "both pages to load", 3000);
+
+        runs(function() {
+            after = phantom.scriptParseCacheStatistics();
+            fs.removeTree(dir);
+
+            expect(results).toEqual([285, 285]);
+            expect(after.capacity).toEqual(8192 * 1024);
+            expect(after.misses - before.misses).toEqual(1);
+            expect(after.hits - before.hits).toEqual(1);
+        });
+    });
+
+    it("should share rendered glyphs between pages", function() {
+        var html = '<html><body><p style="font: 37px serif">Glyphs shared by pages</p></body></html>';
+        var before = phantom.glyphCacheStatistics();
+
+        var first = require('webpage').create();
+        first.setContent(html, 'http://localhost/');
+        first.renderBase64('png');
+        var afterFirst = phantom.glyphCacheStatistics();
+
+        var second = require('webpage').create();
+        second.setContent(html, 'http://localhost/');
+        second.renderBase64('png');
+        var afterSecond = phantom.glyphCacheStatistics();
+        first.close();
+        second.close();
+
+        expect(afterFirst.capacity).toEqual(4096 * 1024);
+        // Rasterized once by the first page...
+        expect(afterFirst.misses).toBeGreaterThan(before.misses);
+        expect(afterFirst.count).toBeGreaterThan(before.count);
+        // ...then reused by the second one
+        expect(afterSecond.misses).toEqual(afterFirst.misses);
+        expect(afterSecond.count).toEqual(afterFirst.count);
+    });
+
+    it("should record trace events between startTracing() and stopTracing()", function() {
+        phantom.startTracing();
+        var page = require('webpage').create();
+        page.setContent('<html><body><p>Trace me</p></body></html>', 'http://localhost/');
+        page.evaluate(function () { return document.body.offsetWidth; });
+        page.renderBase64('png');
+        page.close();
+
+        var trace = JSON.parse(phantom.stopTracing());
+        var names = trace.traceEvents.map(function (e) { return e.name; });
+        expect(names).toContain("HTMLDocumentParser::pumpTokenizer");
+        expect(names).toContain("FrameView::layout");
+        expect(names).toContain("WebPage::renderImage tile");
+        expect(phantom.stopTracing()).toEqual("");
+    });
+
+    it("should profile its own JavaScript between startProfiling() and stopProfiling()", function() {
+        phantom.startProfiling("outer");
+        var squares = [1, 2, 3].map(function square(n) { return n * n; });
+        var profile = phantom.stopProfiling("outer");
+        expect(profile.title).toEqual("outer");
+        expect(typeof profile.totalTime).toEqual("number");
+        expect(profile.head.children.length).toBeGreaterThan(0);
+
+        var cpuProfile = phantom.toCpuProfile(profile);
+        expect(cpuProfile.nodes.length).toBeGreaterThan(1);
+        expect(cpuProfile.endTime).not.toBeLessThan(cpuProfile.startTime);
+    });
+
+    it("should keep resolved host names in the DNS cache file until they expire", function() {
+        var fs = require('fs');
+        var cacheFile = fs.absolute("dns-cache-spec.tmp");
+        // The magic, version and entry count of a cache file without entries
+        var emptySize = 12;
+        var server = require('webserver').create();
+        server.listen(12345, function(request, response) {
+            response.statusCode = 200;
+            response.write('<html><body>cached</body></html>');
+            response.close();
+        });
+
+        var sizes = [];
+        function run(ttl, args) {
+            runPhantomJs(["--dns-cache-file=" + cacheFile, "--dns-cache-ttl=" + ttl,
+                          "fixtures/open-and-exit.js"].concat(args), function() {
+                sizes.push(fs.size(cacheFile));
+            });
+        }
+
+        runs(function() {
+            run(60, ["http://localhost:12345/"]);
+        });
+        waitsFor(function() { return sizes.length === 1; }, "the host name to be resolved", 10000);
+
+        runs(function() {
+            server.close();
+            run(60, []);
+        });
+        waitsFor(function() { return sizes.length === 2; }, "the cache to be loaded again", 10000);
+
+        // Entries older than the time to live are dropped on load
+        waits(1500);
+        runs(function() {
+            run(1, []);
+        });
+        waitsFor(function() { return sizes.length === 3; }, "the cache to expire", 10000);
+
+        runs(function() {
+            fs.remove(cacheFile);
+            expect(sizes[0]).toBeGreaterThan(emptySize);
+            expect(sizes[1]).toEqual(sizes[0]);
+            expect(sizes[2]).toEqual(emptySize);
+        });
+    });
+
+    it("should save the font database to a snapshot file and load it back", function() {
+        var fs = require('fs');
+        var dir = fs.absolute("font-snapshot-spec.tmp");
+        var snapshotFile = dir + "/fonts.snapshot";
+        var widths = [];
+        var modified = [];
+
+        fs.makeDirectory(dir);
+        function run() {
+            runPhantomJs(["--font-snapshot-file=" + snapshotFile, "fixtures/measure-text.js"], function(stdout) {
+                modified.push(fs.lastModified(snapshotFile).getTime());
+                widths.push(Number(stdout.trim()));
+            });
+        }
+
+        runs(run);
+        waitsFor(function() { return widths.length === 1; }, "the snapshot to be saved", 10000);
+
+        runs(function() {
+            // "QFCS", big-endian
+            expect(fs.read(snapshotFile, "b").substr(0, 4)).toEqual("QFCS");
+            run();
+        });
+        waitsFor(function() { return widths.length === 2; }, "the snapshot to be loaded", 10000);
+
+        runs(function() {
+            var files = fs.list(dir).filter(function(name) { return name !== "." && name !== ".."; });
+            fs.removeTree(dir);
+
+            expect(widths[0]).toBeGreaterThan(0);
+            expect(widths[1]).toEqual(widths[0]);
+            // Still up to date: loaded, not written again
+            expect(modified[1]).toEqual(modified[0]);
+            // No temporary file left behind
+            expect(files).toEqual(["fonts.snapshot"]);
+        });
+    });
+
+    it("should reuse the compiled CoffeeScript cached on disk by a previous run", function() {
+        var fs = require('fs');
+        var dir = fs.absolute("script-cache-spec.tmp");
+        var outputs = [];
+        var cached = [];
+
+        function run() {
+            runPhantomJs(["--script-cache=true", "--script-cache-path=" + dir, "fixtures/print-compiled.coffee"], function(stdout) {
+                outputs.push(stdout.trim());
+            });
+        }
+
+        runs(run);
+        waitsFor(function() { return outputs.length === 1; }, "the script to be compiled", 10000);
+
+        runs(function() {
+            // Tamper with the cache entry: the next run has to use it as is
+            cached = fs.list(dir).filter(function(name) { return /\.js$/.test(name); });
+            if (cached.length === 1) {
+                fs.write(dir + "/" + cached[0], 'console.log("from the cache"); phantom.exit();', "w");
+            }
+            run();
+        });
+        waitsFor(function() { return outputs.length === 2; }, "the script to be loaded from the cache", 10000);
+
+        runs(function() {
+            fs.removeTree(dir);
+            expect(cached.length).toEqual(1);
+            expect(outputs[0]).toEqual("compiled");
+            expect(outputs[1]).toEqual("from the cache");
+        });
+    });
+
     it("should be able to get the error signal handler that is currently set on it", function() {
         phantom.onError = undefined;
         expect(phantom.onError).toBeUndefined();
@@ -19,6 +19,17 @@ describe("require()", function() {
         require('./coffee_dummy').should.equal('require/coffee_dummy');
     });
 
+    it("reports CoffeeScript compilation errors", function() {
+        var error;
+        try {
+            require('./coffee_error');
+        } catch (e) {
+            error = e;
+        }
+        should.exist(error);
+        error.message.should.match(/coffee_error\.coffee/);
+    });
+
     it("doesn't expose CoffeeScript", function() {
         should.not.exist(window.CoffeeScript);
     });
@@ -60,6 +60,15 @@ function expectHasPropertyString(o, name) {
 var fs = require('fs');
 fs.changeWorkingDirectory(phantom.libraryPath);
 
+// Runs a script in another PhantomJS, for what can only be set on the command
+// line; calls back with its output once it exited
+function runPhantomJs(args, callback) {
+    var executable = fs.absolute("../bin/phantomjs" + (require('system').os.name === 'windows' ? '.exe' : ''));
+    require('child_process').execFile(executable, args, null, function (err, stdout, stderr) {
+        callback(stdout, stderr);
+    });
+}
+
 // Load specs
 phantom.injectJs("./phantom-spec.js");
 phantom.injectJs("./webpage-spec.js");
@@ -839,6 +839,373 @@ describe("WebPage object", function() {
 
     });
 
+    it("should reuse the keep-alive connection opened by another page", function() {
+        var server = require('webserver').create();
+        var ports = [];
+        server.listen(12345, { keepAlive: true }, function(request, response) {
+            var body = '<html><body>' + request.url + '</body></html>';
+            ports.push(request.remotePort);
+            response.statusCode = 200;
+            response.setHeader('Content-Type', 'text/html');
+            response.setHeader('Content-Length', body.length);
+            response.write(body);
+            response.close();
+        });
+
+        var first = require('webpage').create();
+        var second = require('webpage').create();
+        var loaded = 0;
+        runs(function() {
+            first.open("http://localhost:12345/first", function() {
+                ++loaded;
+                second.open("http://localhost:12345/second", function() {
+                    ++loaded;
+                });
+            });
+        });
+
+        waitsFor(function() {
+            return loaded === 2;
+        }, "both pages to load", 3000);
+
+        runs(function() {
+            // Connections are shared between pages by default
+            expect(ports.length).toEqual(2);
+            expect(ports[1]).toEqual(ports[0]);
+            first.close();
+            second.close();
+            server.close();
+        });
+    });
+
+    it("should report the timing of each phase of a request", function() {
+        var server = require('webserver').create();
+        server.listen(12345, function(request, response) {
+            response.write('<html><body>Timed</body></html>');
+            response.close();
+        });
+
+        var p = require('webpage').create();
+        var timings = null;
+        var navigationTiming = null;
+        runs(function() {
+            p.onResourceReceived = function(resource) {
+                if (resource.stage === 'end') {
+                    timings = resource.timings;
+                }
+            };
+            p.open("http://localhost:12345/timed", function(status) {
+                navigationTiming = p.navigationTiming;
+            });
+        });
+
+        waitsFor(function() {
+            return navigationTiming !== null;
+        }, "the page to load", 3000);
+
+        runs(function() {
+            expect(timings.sendStart).not.toBeLessThan(0);
+            expect(timings.sendEnd).not.toBeLessThan(timings.sendStart);
+            expect(timings.responseStart).not.toBeLessThan(timings.sendEnd);
+            expect(timings.responseEnd).not.toBeLessThan(timings.responseStart);
+            expect(timings.sslStart).toEqual(-1);
+
+            expect(navigationTiming.navigationStart).toBeGreaterThan(0);
+            expect(navigationTiming.responseEnd).not.toBeLessThan(navigationTiming.fetchStart);
+            p.close();
+            server.close();
+        });
+    });
+
+    it("should wait for the network to go idle with waitUntil 'networkidle'", function() {
+        var server = require('webserver').create();
+        server.listen(12345, function(request, response) {
+            if (request.url === '/late.txt') {
+                response.write('late');
+            } else {
+                // Issues one more request well after the load finished
+                response.write('<html><body><script>' +
+                    'setTimeout(function() {' +
+                    '    var xhr = new XMLHttpRequest();' +
+                    '    xhr.open("GET", "/late.txt", true);' +
+                    '    xhr.send();' +
+                    '}, 100);' +
+                    '</script></body></html>');
+            }
+            response.close();
+        });
+
+        var p = require('webpage').create();
+        var received = [];
+        var status = null;
+        var renderIdle = false;
+        runs(function() {
+            p.settings.networkIdleTimeout = 300;
+            p.onResourceReceived = function(resource) {
+                if (resource.stage === 'end') {
+                    received.push(resource.url);
+                }
+            };
+            p.onRenderIdle = function() {
+                renderIdle = true;
+            };
+            p.open("http://localhost:12345/", { waitUntil: 'networkidle' }, function(s) {
+                status = s;
+            });
+        });
+
+        waitsFor(function() {
+            return status !== null;
+        }, "the network to go idle", 3000);
+
+        runs(function() {
+            expect(status).toEqual('success');
+            expect(received).toContain('http://localhost:12345/late.txt');
+        });
+
+        waitsFor(function() {
+            return renderIdle;
+        }, "the rendering to settle", 3000);
+
+        runs(function() {
+            p.close();
+            server.close();
+        });
+    });
+
+    it("should give up waiting for a page that never stops rendering after waitTimeout", function() {
+        var server = require('webserver').create();
+        server.listen(12345, function(request, response) {
+            // Repaints every frame, for ever
+            response.write('<html><body><div id="d">0</div><script>' +
+                'var n = 0;' +
+                'setInterval(function() { document.getElementById("d").textContent = ++n; }, 16);' +
+                '</script></body></html>');
+            response.close();
+        });
+
+        var p = require('webpage').create();
+        var status = null;
+        var start;
+        runs(function() {
+            start = Date.now();
+            p.open("http://localhost:12345/", { waitUntil: 'renderidle', waitTimeout: 500 }, function(s) {
+                status = s;
+            });
+        });
+
+        waitsFor(function() {
+            return status !== null;
+        }, "the wait to time out", 3000);
+
+        runs(function() {
+            expect(status).toEqual('success');
+            expect(Date.now() - start).not.toBeLessThan(500);
+            p.close();
+            server.close();
+        });
+    });
+
+    it("should abort a script that runs for too long", function() {
+        var server = require('webserver').create();
+        server.listen(12345, function(request, response) {
+            response.statusCode = 200;
+            response.write('<html><body><script>while (true) {}</script></body></html>');
+            response.close();
+        });
+
+        var p = require('webpage').create();
+        var timeout = null;
+        var status = null;
+        runs(function() {
+            p.settings.scriptTimeoutMs = 100;
+            p.onScriptTimeout = function(data) {
+                timeout = data;
+            };
+            p.open("http://localhost:12345/", function(s) {
+                status = s;
+            });
+        });
+
+        waitsFor(function() {
+            return timeout !== null && status !== null;
+        }, "the script to be aborted", 5000);
+
+        runs(function() {
+            expect(timeout.reason).toEqual('timeout');
+            expect(timeout.runTime).toBeGreaterThan(99);
+            expect(status).toEqual('success');
+            p.close();
+            server.close();
+        });
+    });
+
+    it("should charge short script runs to the CPU budget of the page", function() {
+        var server = require('webserver').create();
+        server.listen(12345, function(request, response) {
+            response.statusCode = 200;
+            // Runs too short to be checked on their own use up the budget,
+            // then the endless loop has to be aborted at its first check
+            response.write('<html><body><script>' +
+                'function busy(ms) { var end = Date.now() + ms; while (Date.now() < end) {} }' +
+                'var n = 0;' +
+                'var t = setInterval(function() {' +
+                '    busy(25);' +
+                '    if (++n === 16) { clearInterval(t); setTimeout(function() { while (true) {} }, 0); }' +
+                '}, 1);' +
+                '</script></body></html>');
+            response.close();
+        });
+
+        var p = require('webpage').create();
+        var timeout = null;
+        runs(function() {
+            p.settings.scriptCpuBudgetMs = 300;
+            p.onScriptTimeout = function(data) {
+                timeout = data;
+            };
+            p.open("http://localhost:12345/");
+        });
+
+        waitsFor(function() {
+            return timeout !== null;
+        }, "the script to be aborted", 5000);
+
+        runs(function() {
+            expect(timeout.reason).toEqual('budget');
+            expect(timeout.runTime).toBeLessThan(250);
+            expect(timeout.totalTime).not.toBeLessThan(300);
+            p.close();
+            server.close();
+        });
+    });
+
+    it("should emulate the network conditions set for the page", function() {
+        var server = require('webserver').create();
+        server.listen(12345, function(request, response) {
+            response.statusCode = 200;
+            response.write('<html><body>' + new Array(25001).join('x') + '</body></html>');
+            response.close();
+        });
+
+        var p = require('webpage').create();
+        var status = null;
+        var start, elapsed;
+        runs(function() {
+            p.setNetworkConditions({ latencyMs: 200, downloadKbps: 400 });
+            expect(p.networkConditions.latencyMs).toEqual(200);
+            expect(p.networkConditions.offline).toEqual(false);
+            start = new Date().getTime();
+            p.open("http://localhost:12345/", function(s) {
+                elapsed = new Date().getTime() - start;
+                status = s;
+            });
+        });
+
+        waitsFor(function() {
+            return status !== null;
+        }, "the throttled page to load", 5000);
+
+        runs(function() {
+            expect(status).toEqual('success');
+            // 200 ms of latency, and 400 ms for the 25 KB beyond the initial burst
+            expect(elapsed).toBeGreaterThan(500);
+
+            status = null;
+            p.setNetworkConditions({ offline: true });
+            p.open("http://localhost:12345/", function(s) {
+                status = s;
+            });
+        });
+
+        waitsFor(function() {
+            return status !== null;
+        }, "the offline page to fail", 3000);
+
+        runs(function() {
+            expect(status).toEqual('fail');
+            p.close();
+            server.close();
+        });
+    });
+
+    it("should hold back the data lost with the packet loss set for the page", function() {
+        var server = require('webserver').create();
+        server.listen(12345, function(request, response) {
+            response.statusCode = 200;
+            // Three segments
+            response.write('<html><body>' + new Array(4001).join('x') + '</body></html>');
+            response.close();
+        });
+
+        var p = require('webpage').create();
+        var status = null;
+        var start, elapsed;
+        runs(function() {
+            p.setNetworkConditions({ packetLossPercent: 100 });
+            expect(p.networkConditions.packetLossPercent).toEqual(100);
+            start = new Date().getTime();
+            p.open("http://localhost:12345/", function(s) {
+                elapsed = new Date().getTime() - start;
+                status = s;
+            });
+        });
+
+        waitsFor(function() {
+            return status !== null;
+        }, "the lossy page to load", 5000);
+
+        runs(function() {
+            expect(status).toEqual('success');
+            // Every segment is resent after at least 200 ms
+            expect(elapsed).not.toBeLessThan(600);
+            p.close();
+            server.close();
+        });
+    });
+
+    it("should report a failed authentication under the id of a throttled request", function() {
+        var server = require('webserver').create();
+        server.listen(12345, function(request, response) {
+            response.statusCode = 401;
+            response.setHeader('WWW-Authenticate', 'Basic realm="PhantomJS test"');
+            response.write('Authentication Required');
+            response.close();
+        });
+
+        var p = require('webpage').create();
+        var requested = [];
+        var received = [];
+        var status = null;
+        runs(function() {
+            p.setNetworkConditions({ latencyMs: 50 });
+            p.onResourceRequested = function(request) {
+                requested.push(request.id);
+            };
+            p.onResourceReceived = function(response) {
+                if (response.stage === 'end') {
+                    received.push(response);
+                }
+            };
+            p.open("http://localhost:12345/", function(s) {
+                status = s;
+            });
+        });
+
+        waitsFor(function() {
+            return status !== null;
+        }, "the authentication to fail", 3000);
+
+        runs(function() {
+            expect(status).toEqual('fail');
+            expect(received.length).toEqual(1);
+            expect(received[0].status).toEqual(401);
+            expect(received[0].id).toEqual(requested[0]);
+            p.close();
+            server.close();
+        });
+    });
+
     it("should set valid cookie properly, then remove it", function() {
         var server = require('webserver').create();
         server.listen(12345, function(request, response) {
@@ -1632,6 +1999,32 @@ describe("WebPage switch frame of execution", function(){
         expect(p.switchToFocusedFrame()).toBeUndefined();
         expect(p.frameName).toEqual("frame1");
     });
+
+    it("should pick the overload matching the arguments on every call", function(){
+        // Once the resolution of a call is cached, a different argument type
+        // must still pick the other overload
+        var names = [];
+        var expected = [];
+        for (var i = 0; i < 200; ++i) {
+            p.switchToMainFrame();
+            switch (i % 4) {
+            case 0:
+                p.switchToFrame(1);         // switchToFrame(int)
+                break;
+            case 1:
+                p.switchToFrame("frame1");  // switchToFrame(QString)
+                break;
+            case 2:
+                p.switchToFrame("1");       // no frame named "1"
+                break;
+            default:
+                p.switchToFrame(0);
+            }
+            names.push(p.frameName);
+            expected.push(["frame2", "frame1", "", "frame1"][i % 4]);
+        }
+        expect(names).toEqual(expected);
+    });
 });
 
 describe("WebPage opening and closing of windows/child-pages", function(){
@@ -2045,6 +2438,39 @@ describe("WebPage render image", function(){
         }
     }
 
+    // Decodes a PNG, rendered as base64, in a scratch page: calls back with
+    // its width, height and RGBA pixels
+    function readPixels(base64, callback) {
+        var reader = require("webpage").create();
+        reader.onCallback = function (image) {
+            setTimeout(function () {
+                reader.close();
+                callback(image);
+            }, 0);
+        };
+        reader.evaluate(function (src) {
+            var img = new Image();
+            img.onload = function () {
+                var canvas = document.createElement("canvas");
+                canvas.width = img.width;
+                canvas.height = img.height;
+                var context = canvas.getContext("2d");
+                context.drawImage(img, 0, 0);
+                window.callPhantom({
+                    width: img.width,
+                    height: img.height,
+                    pixels: Array.prototype.slice.call(context.getImageData(0, 0, img.width, img.height).data)
+                });
+            };
+            img.src = src;
+        }, "data:image/png;base64," + base64);
+    }
+
+    function pixelAt(image, x, y) {
+        var i = (y * image.width + x) * 4;
+        return image.pixels.slice(i, i + 4);
+    }
+
     it("should render PDF file", function(){
         p.open( TEST_FILE_DIR + "index.html", function () {
             render_test("pdf");
@@ -2057,6 +2483,29 @@ describe("WebPage render image", function(){
         });
     });
 
+    it("should embed JPEG images in PDF files as downloaded", function(){
+        p.open( TEST_FILE_DIR + "index.html", function () {
+            var TEST_FILE = TEST_FILE_DIR + "temp_testjpeg.pdf";
+            p.render(TEST_FILE);
+
+            var content = fs.read(TEST_FILE, "b");
+            fs.remove(TEST_FILE);
+            expect(content.indexOf(fs.read(TEST_FILE_DIR + "image.jpg", "b"))).not.toEqual(-1);
+        });
+    });
+
+    it("should render PDF file with lossless images", function(){
+        p.open( TEST_FILE_DIR + "index.html", function () {
+            var TEST_FILE = TEST_FILE_DIR + "temp_testlossless.pdf";
+            p.render(TEST_FILE, { imageCompression: 'lossless' });
+
+            var content = fs.read(TEST_FILE, "b");
+            fs.remove(TEST_FILE);
+            expect(content.indexOf("/DCTDecode")).toEqual(-1);
+            expect(content.indexOf("/FlateDecode")).not.toEqual(-1);
+        });
+    });
+
     it("should render GIF file", function(){
         p.open( TEST_FILE_DIR + "index.html", function () {
             render_test("gif");
@@ -2093,6 +2542,400 @@ describe("WebPage render image", function(){
         });
     });
 
+    it("should paint large images decoded in the background", function(){
+        var page = require("webpage").create();
+        var image = null;
+
+        runs(function () {
+            page.viewportSize = { width: 300, height: 300 };
+            page.onCallback = function () {
+                setTimeout(function () {
+                    readPixels(page.renderBase64("png"), function (result) {
+                        image = result;
+                    });
+                }, 0);
+            };
+            page.evaluate(function () {
+                // Large enough for the decoding to still be running when painted
+                var canvas = document.createElement("canvas");
+                canvas.width = canvas.height = 2000;
+                var context = canvas.getContext("2d");
+                context.fillStyle = "rgb(255, 0, 0)";
+                context.fillRect(0, 0, 2000, 2000);
+
+                var img = new Image();
+                img.onload = function () {
+                    window.callPhantom();
+                };
+                document.body.style.margin = "0";
+                document.body.appendChild(img);
+                img.src = canvas.toDataURL("image/png");
+            });
+        });
+
+        waitsFor(function () {
+            return image !== null;
+        }, "the page to be rendered", 10000);
+
+        runs(function () {
+            expect(image.width).toEqual(300);
+            expect(pixelAt(image, 150, 150)).toEqual([255, 0, 0, 255]);
+            page.close();
+        });
+    });
+
+    it("should paint images smaller than their size from a reduced decode", function(){
+        var page = require("webpage").create();
+        var server = require("webserver").create();
+        var images = [];
+        var decodedSizes = [];
+
+        // One color per quadrant, to catch a misplaced source rectangle
+        var png = atob(page.evaluate(function () {
+            var canvas = document.createElement("canvas");
+            canvas.width = canvas.height = 1600;
+            var context = canvas.getContext("2d");
+            context.fillStyle = "rgb(255, 0, 0)";
+            context.fillRect(0, 0, 800, 800);
+            context.fillStyle = "rgb(0, 255, 0)";
+            context.fillRect(800, 0, 800, 800);
+            context.fillStyle = "rgb(0, 0, 255)";
+            context.fillRect(0, 800, 800, 800);
+            context.fillStyle = "rgb(0, 0, 0)";
+            context.fillRect(800, 800, 800, 800);
+            return canvas.toDataURL("image/png").split(",")[1];
+        }));
+        server.listen(12345, function(request, response) {
+            response.statusCode = 200;
+            response.setHeader("Content-Type", "image/png");
+            response.setEncoding("binary");
+            response.write(png);
+            response.close();
+        });
+
+        // Decoded size of the images in the memory cache, this one included
+        function decodedSize() {
+            return phantom.memoryCacheStatistics().images.decodedSize;
+        }
+
+        function render() {
+            var base64 = page.renderBase64("png");
+            decodedSizes.push(decodedSize());
+            readPixels(base64, function (result) {
+                images.push(result);
+            });
+        }
+
+        var before;
+        runs(function () {
+            before = decodedSize();
+            page.viewportSize = { width: 400, height: 400 };
+            page.onCallback = function () {
+                setTimeout(render, 0);
+            };
+            page.evaluate(function () {
+                var img = new Image();
+                img.id = "scaled";
+                img.style.width = img.style.height = "200px";
+                img.onload = function () {
+                    window.callPhantom();
+                };
+                document.body.style.margin = "0";
+                document.body.appendChild(img);
+                img.src = "http://localhost:12345/quadrants.png";
+            });
+        });
+
+        waitsFor(function () {
+            return images.length === 1;
+        }, "the page to be rendered at 1/8", 10000);
+
+        runs(function () {
+            expect(pixelAt(images[0], 50, 50)).toEqual([255, 0, 0, 255]);
+            expect(pixelAt(images[0], 150, 50)).toEqual([0, 255, 0, 255]);
+            expect(pixelAt(images[0], 50, 150)).toEqual([0, 0, 255, 255]);
+            expect(pixelAt(images[0], 150, 150)).toEqual([0, 0, 0, 255]);
+
+            // Painted larger again, the image is decoded at a larger size
+            page.evaluate(function () {
+                var img = document.getElementById("scaled");
+                img.style.width = img.style.height = "400px";
+            });
+            render();
+        });
+
+        waitsFor(function () {
+            return images.length === 2;
+        }, "the page to be rendered at 1/4", 10000);
+
+        runs(function () {
+            expect(pixelAt(images[1], 100, 100)).toEqual([255, 0, 0, 255]);
+            expect(pixelAt(images[1], 300, 100)).toEqual([0, 255, 0, 255]);
+            expect(pixelAt(images[1], 100, 300)).toEqual([0, 0, 255, 255]);
+            expect(pixelAt(images[1], 300, 300)).toEqual([0, 0, 0, 255]);
+
+            // Only the reduced frames were decoded: 200x200 then 400x400
+            // pixels, where the full frame would take 1600x1600
+            var fullFrame = 1600 * 1600 * 4;
+            expect(decodedSizes[0] - before).toBeLessThan(fullFrame / 16);
+            expect(decodedSizes[1] - before).toBeLessThan(fullFrame / 4);
+            expect(decodedSizes[1]).toBeGreaterThan(decodedSizes[0]);
+            page.close();
+            server.close();
+        });
+    });
+
+    it("should render PNG file with fast quality option", function(){
+        var images = [];
+
+        runs(function () {
+            p.open( TEST_FILE_DIR + "index.html", function () {
+                // Encoded differently from a default render, but decodes to the same pixels
+                [{ format: 'png', quality: 'fast' }, { format: 'png' }].forEach(function (option, i) {
+                    var TEST_FILE = TEST_FILE_DIR + "temp_testfast" + i + ".png";
+                    p.render(TEST_FILE, option);
+                    var content = fs.read(TEST_FILE, "b");
+                    fs.remove(TEST_FILE);
+                    readPixels(btoa(content), function (image) {
+                        images[i] = image;
+                    });
+                });
+            });
+        });
+
+        waitsFor(function () {
+            return images[0] && images[1];
+        }, "both renders to be decoded", 5000);
+
+        runs(function () {
+            expect(images[0].width).toEqual(300);
+            expect(images[0].height).toEqual(300);
+            expect(images[0].width).toEqual(images[1].width);
+            expect(images[0].height).toEqual(images[1].height);
+            expect(images[0].pixels).toEqual(images[1].pixels);
+        });
+    });
+
+    it("should render PNG file on an opaque background", function(){
+        p.open( TEST_FILE_DIR + "index.html", function () {
+            var TEST_FILE = TEST_FILE_DIR + "temp_testbackground.png";
+            p.render(TEST_FILE, { format: 'png', background: '#ffffff' });
+
+            // Written without an alpha channel: color type 2 (RGB) in the IHDR chunk
+            var content = fs.read(TEST_FILE, "b");
+            fs.remove(TEST_FILE);
+            expect(content.substr(1, 3)).toEqual("PNG");
+            expect(content.charCodeAt(25)).toEqual(2);
+        });
+    });
+
+    it("should render base64 PNG on an opaque background", function(){
+        var page = require("webpage").create();
+        page.setContent('<html><body>Opaque</body></html>', 'http://localhost/');
+
+        // Color type in the IHDR chunk: 2 (RGB) without alpha channel, 6 (RGBA) with
+        var opaque = atob(page.renderBase64("png", { background: '#ffffff' }));
+        var transparent = atob(page.renderBase64("png"));
+        page.close();
+        expect(opaque.substr(1, 3)).toEqual("PNG");
+        expect(opaque.charCodeAt(25)).toEqual(2);
+        expect(transparent.charCodeAt(25)).toEqual(6);
+    });
+
+    it("should render twice as many pixels with a device pixel ratio of 2", function(){
+        var sizes = [];
+
+        runs(function () {
+            runPhantomJs(["fixtures/render-size.js"], function (stdout) {
+                sizes[0] = JSON.parse(stdout);
+            });
+            runPhantomJs(["--device-pixel-ratio=2", "fixtures/render-size.js"], function (stdout) {
+                sizes[1] = JSON.parse(stdout);
+            });
+        });
+
+        waitsFor(function () {
+            return sizes[0] && sizes[1];
+        }, "both processes to render", 20000);
+
+        runs(function () {
+            expect(sizes[0]).toEqual({ width: 200, height: 100 });
+            expect(sizes[1]).toEqual({ width: 400, height: 200 });
+        });
+    });
+
+    it("should compose the same pixels with the AVX2 and the SSE2 drawhelpers", function(){
+        // Without AVX2 both processes would run the SSE2 kernels
+        var cpuinfo = fs.exists("/proc/cpuinfo") ? fs.read("/proc/cpuinfo") : "";
+        if (!/^flags\s*:.*\bavx2\b/m.test(cpuinfo)) {
+            console.log("Skipping the AVX2 drawhelper comparison: this CPU does not report AVX2");
+            return;
+        }
+
+        var renders = [];
+
+        runs(function () {
+            runPhantomJs(["fixtures/render-blends.js"], function (stdout) {
+                renders[0] = JSON.parse(stdout);
+            });
+            // Forces the SSE2 kernels
+            var executable = fs.absolute("../bin/phantomjs");
+            require('child_process').execFile("/usr/bin/env", ["QT_NO_CPU_FEATURE=avx2", executable, "fixtures/render-blends.js"], null, function (err, stdout) {
+                renders[1] = JSON.parse(stdout);
+            });
+        });
+
+        waitsFor(function () {
+            return renders[0] && renders[1];
+        }, "both processes to render", 20000);
+
+        runs(function () {
+            ["sourceOver", "constantAlpha", "scaled", "rotated"].forEach(function (name) {
+                expect(renders[0][name].length).toBeGreaterThan(0);
+                expect(renders[0][name]).toEqual(renders[1][name]);
+            });
+        });
+    });
+
+    it("should render into a shared memory object", function(){
+        if (!fs.isDirectory("/dev/shm")) {
+            return;
+        }
+        p.open( TEST_FILE_DIR + "index.html", function () {
+            expect(p.renderToSharedMemory("/phantomjs-spec-frame")).toBeTruthy();
+            expect(p.renderToSharedMemory("/phantomjs-spec-frame", { format: "png" })).toBeTruthy();
+
+            var content = fs.read("/dev/shm/phantomjs-spec-frame", "b");
+            fs.remove("/dev/shm/phantomjs-spec-frame");
+            function field(offset) {
+                return content.charCodeAt(offset) | (content.charCodeAt(offset + 1) << 8)
+                    | (content.charCodeAt(offset + 2) << 16) | (content.charCodeAt(offset + 3) << 24);
+            }
+            expect(content.substr(0, 4)).toEqual("PJSF");
+            // sequence number of the second frame, even once complete, then the encoding
+            expect(field(28)).toEqual(4);
+            expect(content.substr(32, 3)).toEqual("png");
+            expect(content.substr(65, 3)).toEqual("PNG");
+            // Not shrunk to the PNG: still large enough for the raw frame
+            expect(field(24)).toBeLessThan(field(8) * field(12) * 4);
+            expect(content.length).not.toBeLessThan(64 + field(8) * field(12) * 4);
+        });
+    });
+
+});
+
+describe("WebPage profiling", function(){
+    var page = require("webpage").create();
+
+    it("should profile the JavaScript of the page", function() {
+        page.startProfiling("fib");
+        page.evaluate(function () {
+            function fib(n) {
+                return n < 2 ? n : fib(n - 1) + fib(n - 2);
+            }
+            return fib(12);
+        });
+        var profile = page.stopProfiling("fib");
+
+        function find(node, name) {
+            if (node.functionName === name) {
+                return node;
+            }
+            for (var i = 0; i < node.children.length; ++i) {
+                var found = find(node.children[i], name);
+                if (found) {
+                    return found;
+                }
+            }
+            return null;
+        }
+
+        expect(profile.title).toEqual("fib");
+        var fib = find(profile.head, "fib");
+        expect(fib).not.toBeNull();
+        expect(fib.callCount).toBeGreaterThan(0);
+        expect(fib.totalTime).not.toBeLessThan(fib.selfTime);
+
+        var cpuProfile = phantom.toCpuProfile(profile);
+        expect(cpuProfile.nodes[0].callFrame.functionName).toEqual("(root)");
+        expect(cpuProfile.samples.length).toEqual(cpuProfile.timeDeltas.length);
+
+        expect(page.stopProfiling("fib")).toEqual({});
+    });
+});
+
+describe("Virtual time", function(){
+    var page = require("webpage").create();
+
+    it("should fire timers when virtual time is advanced", function() {
+        var loaded = false;
+        var elapsed, before, after;
+
+        runs(function() {
+            page.open("webpage-spec-renders/index.html", function () {
+                loaded = true;
+            });
+        });
+
+        waitsFor(function () {
+            return loaded;
+        }, "the page to load", 3000);
+
+        runs(function() {
+            page.setVirtualTime(true, false);
+            elapsed = page.evaluate(function () {
+                window.__virtualStart = Date.now();
+                window.__virtualFired = -1;
+                setTimeout(function () {
+                    window.__virtualFired = Date.now() - window.__virtualStart;
+                }, 60000);
+                return Date.now() - window.__virtualStart;
+            });
+            page.advanceTime(59999);
+            before = page.evaluate(function () { return window.__virtualFired; });
+            page.advanceTime(1);
+            after = page.evaluate(function () { return window.__virtualFired; });
+        });
+
+        runs(function() {
+            page.setVirtualTime(false);
+            expect(elapsed).toEqual(0);
+            expect(before).toEqual(-1);
+            expect(after).toEqual(60000);
+        });
+    });
+
+    it("should fast-forward timer chains in virtual time", function() {
+        var elapsed = -1;
+
+        runs(function() {
+            page.onCallback = function (virtualElapsed) {
+                elapsed = virtualElapsed;
+            };
+            page.setVirtualTime(true);
+            page.evaluate(function () {
+                var start = Date.now();
+                var count = 0;
+                (function tick() {
+                    if (++count === 100) {
+                        window.callPhantom(Date.now() - start);
+                    } else {
+                        setTimeout(tick, 1000);
+                    }
+                })();
+            });
+        });
+
+        waitsFor(function () {
+            return elapsed !== -1;
+        }, "100 seconds worth of timers", 5000);
+
+        runs(function() {
+            page.setVirtualTime(false);
+            page.onCallback = null;
+            expect(elapsed).not.toBeLessThan(99000);
+        });
+    });
 });
 
 describe("WebPage network request headers handling", function() {
@@ -2194,3 +3037,186 @@ describe("WebPage network request headers handling", function() {
         });
     });
 });
+
+describe("WebPage network archive", function() {
+    var fs = require("fs");
+    var archive = fs.absolute("network-archive-spec.tmp");
+    var base = "http://localhost:12345";
+
+    function serve(server) {
+        server.listen(12345, function(request, response) {
+            switch (request.url) {
+            case "/page":
+                response.statusCode = 201;
+                response.setHeader("Content-Type", "text/html");
+                response.setHeader("X-Archived", "yes");
+                response.setHeader("Set-Cookie", "archived=1; path=/");
+                response.write('<html><body><p>archived page</p><script>' +
+                    'var xhr = new XMLHttpRequest(); xhr.open("GET", "/sync", false); xhr.send();' +
+                    'document.body.appendChild(document.createTextNode(xhr.responseText));' +
+                    '</script></body></html>');
+                break;
+            case "/sync":
+                response.statusCode = 200;
+                response.setHeader("Content-Type", "text/plain");
+                response.write("synchronous body");
+                break;
+            case "/redirect":
+                response.statusCode = 302;
+                response.setHeader("Location", base + "/target");
+                response.write("");
+                break;
+            default:
+                response.statusCode = 200;
+                response.setHeader("Content-Type", "text/html");
+                response.write("<html><body>target page</body></html>");
+            }
+            response.close();
+        });
+    }
+
+    function run(mode, file, callback) {
+        runPhantomJs(["--network-archive=" + file, "--network-archive-mode=" + mode,
+                      "fixtures/network-archive.js", base, mode], function(stdout) {
+            callback(JSON.parse(stdout));
+        });
+    }
+
+    var recorded = null;
+
+    it("should record the responses to network requests", function() {
+        var server = require("webserver").create();
+        serve(server);
+
+        runs(function() {
+            run("record", archive, function(result) {
+                recorded = result;
+            });
+        });
+
+        waitsFor(function() {
+            return recorded !== null;
+        }, "the pages to be recorded", 10000);
+
+        runs(function() {
+            server.close();
+            expect(recorded.page.status).toEqual("success");
+            expect(recorded.page.text).toContain("archived page");
+            expect(recorded.page.text).toContain("synchronous body");
+            expect(recorded.responses["/page"].status).toEqual(201);
+            expect(recorded.responses["/redirect"].status).toEqual(302);
+            expect(recorded.redirect.url).toEqual("/target");
+            expect(fs.read(archive, "b").substr(0, 4)).toEqual("PJNA");
+        });
+    });
+
+    it("should replay the recorded responses without the network", function() {
+        var replayed = null;
+
+        // Nothing listens on the port any more
+        runs(function() {
+            run("replay", archive, function(result) {
+                replayed = result;
+            });
+        });
+
+        waitsFor(function() {
+            return replayed !== null;
+        }, "the pages to be replayed", 10000);
+
+        runs(function() {
+            // Status, reason phrase, headers and bodies, including of the synchronous request
+            expect(replayed.page).toEqual(recorded.page);
+            expect(replayed.responses["/page"]).toEqual(recorded.responses["/page"]);
+            expect(replayed.responses["/page"].statusText).toEqual("Created");
+            expect(replayed.responses["/page"].headers["X-Archived"]).toEqual("yes");
+            expect(replayed.responses["/sync"]).toEqual(recorded.responses["/sync"]);
+
+            // Redirects are followed
+            expect(replayed.responses["/redirect"]).toEqual(recorded.responses["/redirect"]);
+            expect(replayed.redirect).toEqual(recorded.redirect);
+
+            // Cookies are set from the archived response
+            expect(replayed.cookies).toContain("archived=1");
+
+            // What was not recorded is not found
+            expect(replayed.missing).toEqual("fail");
+            expect(replayed.errors["/missing"]).toEqual(203);
+        });
+    });
+
+    it("should replay an archive whose recording was not closed", function() {
+        var unclosed = fs.absolute("network-archive-unclosed-spec.tmp");
+        var replayed = null;
+
+        runs(function() {
+            // Cut the index and trailer off: the trailer ends with the offset of
+            // the index (big-endian 64 bits, of which the high half is 0 here)
+            // and the magic
+            var content = fs.read(archive, "b");
+            var trailer = content.length - 12;
+            var indexOffset = 0;
+            for (var i = 4; i < 8; ++i) {
+                indexOffset = indexOffset * 256 + content.charCodeAt(trailer + i);
+            }
+            fs.write(unclosed, content.substr(0, indexOffset), "wb");
+
+            run("replay", unclosed, function(result) {
+                replayed = result;
+            });
+        });
+
+        waitsFor(function() {
+            return replayed !== null;
+        }, "the pages to be replayed", 10000);
+
+        runs(function() {
+            fs.remove(unclosed);
+            fs.remove(archive);
+            expect(replayed.page).toEqual(recorded.page);
+            expect(replayed.responses["/page"]).toEqual(recorded.responses["/page"]);
+            expect(replayed.redirect).toEqual(recorded.redirect);
+            expect(replayed.errors["/missing"]).toEqual(203);
+        });
+    });
+
+    it("should not run the script without the archive to replay", function() {
+        var output = null;
+
+        runs(function() {
+            runPhantomJs(["--network-archive=" + fs.absolute("network-archive-missing.tmp"),
+                          "fixtures/network-archive.js", base, "replay"], function(stdout, stderr) {
+                output = { stdout: stdout, stderr: stderr };
+            });
+        });
+
+        waitsFor(function() {
+            return output !== null;
+        }, "phantomjs to give up", 10000);
+
+        runs(function() {
+            expect(output.stdout).toEqual("");
+            expect(output.stderr).toContain("Unable to open network archive");
+        });
+    });
+
+    it("should reject an unknown archive mode", function() {
+        var output = null;
+
+        runs(function() {
+            runPhantomJs(["--network-archive=" + archive, "--network-archive-mode=playback",
+                          "fixtures/network-archive.js", base, "replay"], function(stdout, stderr) {
+                output = { stdout: stdout, stderr: stderr };
+            });
+        });
+
+        waitsFor(function() {
+            return output !== null;
+        }, "phantomjs to give up", 10000);
+
+        runs(function() {
+            expect(output.stdout).toEqual("");
+            expect(output.stderr).toContain("network-archive-mode");
+        });
+    });
+});